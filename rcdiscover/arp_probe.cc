@@ -0,0 +1,467 @@
+/*
+ * rcdiscover - the network discovery tool for Roboception devices
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "arp_probe.h"
+
+#include "socket_exception.h"
+#include "operation_not_permitted.h"
+
+#ifdef WIN32
+#include <winsock2.h>
+#include <iphlpapi.h>
+#include <future>
+#else
+#include <sys/socket.h>
+#include <sys/ioctl.h>
+#include <net/if.h>
+#include <arpa/inet.h>
+#include <linux/if_packet.h>
+#include <linux/if_ether.h>
+#include <ifaddrs.h>
+#include <poll.h>
+#include <unistd.h>
+#include <errno.h>
+#endif
+
+#include <chrono>
+#include <map>
+#include <algorithm>
+#include <cstring>
+
+namespace rcdiscover
+{
+
+#ifdef WIN32
+
+std::vector<ArpProbe::Result> ArpProbe::check(const std::vector<Probe> &probes,
+                                              int, int)
+{
+  // SendARP() blocks until an answer is received or its own timeout
+  // expires, so that all addresses are resolved in parallel
+
+  std::vector<std::future<Result> > pending;
+  for (const auto &probe : probes)
+  {
+    pending.push_back(std::async(std::launch::async, [probe]()
+    {
+      Result result{true, false, 0};
+
+      ULONG mac[2];
+      ULONG len=6;
+      if (SendARP(htonl(probe.ip), 0, mac, &len) == NO_ERROR && len == 6)
+      {
+        const uint8_t *p=reinterpret_cast<const uint8_t *>(mac);
+        for (int i=0; i<6; i++)
+        {
+          result.mac=(result.mac<<8) | p[i];
+        }
+
+        result.conflict=(result.mac != probe.own_mac);
+      }
+
+      return result;
+    }));
+  }
+
+  std::vector<Result> results;
+  for (auto &p : pending)
+  {
+    results.push_back(p.get());
+  }
+
+  return results;
+}
+
+#else
+
+namespace
+{
+
+struct Interface
+{
+  int index;
+  uint64_t mac;
+  uint8_t hwaddr[6];
+  uint32_t ip;
+  uint32_t mask;
+};
+
+/*
+  Returns all IPv4 interfaces with their address and MAC address, except
+  loopback.
+*/
+
+std::map<std::string, Interface> getInterfaces()
+{
+  std::map<std::string, Interface> ret;
+
+  ifaddrs *addrs=nullptr;
+  if (getifaddrs(&addrs) != 0)
+  {
+    throw SocketException("Error while getting interface addresses", errno);
+  }
+
+  const int fd=::socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+
+  for (ifaddrs *a=addrs; a != nullptr; a=a->ifa_next)
+  {
+    if (a->ifa_addr == nullptr || a->ifa_netmask == nullptr ||
+        a->ifa_addr->sa_family != AF_INET || (a->ifa_flags & IFF_LOOPBACK) ||
+        ret.count(a->ifa_name) > 0)
+    {
+      continue;
+    }
+
+    Interface iface;
+    memset(&iface, 0, sizeof(iface));
+
+    iface.index=static_cast<int>(if_nametoindex(a->ifa_name));
+    iface.ip=ntohl(reinterpret_cast<sockaddr_in *>(a->ifa_addr)->sin_addr.s_addr);
+    iface.mask=ntohl(reinterpret_cast<sockaddr_in *>(a->ifa_netmask)->sin_addr.s_addr);
+
+    ifreq ifr;
+    memset(&ifr, 0, sizeof(ifr));
+    strncpy(ifr.ifr_name, a->ifa_name, IFNAMSIZ-1);
+
+    if (fd >= 0 && ioctl(fd, SIOCGIFHWADDR, &ifr) == 0)
+    {
+      memcpy(iface.hwaddr, ifr.ifr_hwaddr.sa_data, 6);
+      for (int i=0; i<6; i++)
+      {
+        iface.mac=(iface.mac<<8) | iface.hwaddr[i];
+      }
+    }
+
+    ret[a->ifa_name]=iface;
+  }
+
+  if (fd >= 0)
+  {
+    ::close(fd);
+  }
+
+  freeifaddrs(addrs);
+
+  return ret;
+}
+
+/*
+  Packet socket of one interface together with the indices of the probes that
+  are sent via this interface.
+*/
+
+struct Group
+{
+  Group() : fd(-1) { }
+  ~Group()
+  {
+    if (fd >= 0)
+    {
+      ::close(fd);
+    }
+  }
+
+  Group(const Group &)=delete;
+  Group &operator=(const Group &)=delete;
+
+  int fd;
+  Interface iface;
+  std::vector<size_t> probes;
+};
+
+uint64_t toMAC(const uint8_t *p)
+{
+  uint64_t mac=0;
+  for (int i=0; i<6; i++)
+  {
+    mac=(mac<<8) | p[i];
+  }
+
+  return mac;
+}
+
+uint32_t toIP(const uint8_t *p)
+{
+  return (static_cast<uint32_t>(p[0])<<24) | (static_cast<uint32_t>(p[1])<<16) |
+    (static_cast<uint32_t>(p[2])<<8) | static_cast<uint32_t>(p[3]);
+}
+
+}
+
+std::vector<ArpProbe::Result> ArpProbe::check(const std::vector<Probe> &probes,
+                                              int window, int count)
+{
+  typedef std::chrono::steady_clock clock;
+
+  std::vector<Result> results(probes.size(), Result{false, false, 0});
+
+  // assign all probes to interfaces
+
+  const std::map<std::string, Interface> ifaces=getInterfaces();
+  std::map<std::string, Group> groups;
+
+  for (size_t i=0; i<probes.size(); i++)
+  {
+    const Probe &probe=probes[i];
+
+    auto iface=ifaces.end();
+    if (probe.iface.empty())
+    {
+      for (auto it=ifaces.begin(); it != ifaces.end(); ++it)
+      {
+        if ((probe.ip & it->second.mask) == (it->second.ip & it->second.mask))
+        {
+          iface=it;
+          break;
+        }
+      }
+    }
+    else
+    {
+      iface=ifaces.find(probe.iface);
+    }
+
+    if (iface == ifaces.end())
+    {
+      continue;
+    }
+
+    results[i].checked=true;
+
+    // addresses of this host are in use as well
+
+    for (const auto &local : ifaces)
+    {
+      if (local.second.ip == probe.ip)
+      {
+        results[i].conflict=true;
+        results[i].mac=local.second.mac;
+      }
+    }
+
+    if (!results[i].conflict)
+    {
+      Group &group=groups[iface->first];
+      group.iface=iface->second;
+      group.probes.push_back(i);
+    }
+  }
+
+  if (groups.empty())
+  {
+    return results;
+  }
+
+  // open one packet socket per interface
+
+  std::vector<pollfd> fds;
+  std::vector<Group *> fd_group;
+
+  for (auto &g : groups)
+  {
+    Group &group=g.second;
+
+    group.fd=::socket(AF_PACKET, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC,
+                      htons(ETH_P_ARP));
+
+    if (group.fd < 0)
+    {
+      if (errno == EPERM || errno == EACCES)
+      {
+        throw OperationNotPermitted();
+      }
+
+      throw SocketException("Error while creating packet socket", errno);
+    }
+
+    sockaddr_ll addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sll_family=AF_PACKET;
+    addr.sll_protocol=htons(ETH_P_ARP);
+    addr.sll_ifindex=group.iface.index;
+
+    if (::bind(group.fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) != 0)
+    {
+      throw SocketException("Error while binding packet socket to interface", errno);
+    }
+
+    pollfd pfd;
+    pfd.fd=group.fd;
+    pfd.events=POLLIN;
+    pfd.revents=0;
+
+    fds.push_back(pfd);
+    fd_group.push_back(&group);
+  }
+
+  // send probes evenly distributed over the first part of the window and
+  // watch all ARP packets until the end of the window
+
+  count=std::max(1, count);
+  window=std::max(1, window);
+
+  const auto start=clock::now();
+  const auto end=start+std::chrono::milliseconds(window);
+  const auto interval=std::chrono::milliseconds(window)/(count+1);
+
+  int sent=0;
+  auto next_send=start;
+
+  auto now=start;
+  while (now < end)
+  {
+    if (sent < count && now >= next_send)
+    {
+      for (auto &g : groups)
+      {
+        Group &group=g.second;
+
+        uint8_t p[28];
+        p[0]=0x00; p[1]=0x01;   // hardware type: ethernet
+        p[2]=0x08; p[3]=0x00;   // protocol type: IPv4
+        p[4]=6;                 // hardware address length
+        p[5]=4;                 // protocol address length
+        p[6]=0x00; p[7]=0x01;   // operation: request
+        memcpy(p+8, group.iface.hwaddr, 6);   // sender hardware address
+        memset(p+14, 0, 4);                   // sender IP address: 0.0.0.0
+        memset(p+18, 0, 6);                   // target hardware address
+
+        sockaddr_ll dst;
+        memset(&dst, 0, sizeof(dst));
+        dst.sll_family=AF_PACKET;
+        dst.sll_protocol=htons(ETH_P_ARP);
+        dst.sll_ifindex=group.iface.index;
+        dst.sll_halen=6;
+        memset(dst.sll_addr, 0xff, 6);
+
+        for (size_t i : group.probes)
+        {
+          if (results[i].conflict)
+          {
+            continue;
+          }
+
+          p[24]=static_cast<uint8_t>(probes[i].ip >> 24); // target IP address
+          p[25]=static_cast<uint8_t>(probes[i].ip >> 16);
+          p[26]=static_cast<uint8_t>(probes[i].ip >> 8);
+          p[27]=static_cast<uint8_t>(probes[i].ip);
+
+          // errors are ignored, since other probes are sent later
+
+          ::sendto(group.fd, p, sizeof(p), 0,
+                   reinterpret_cast<const sockaddr *>(&dst), sizeof(dst));
+        }
+      }
+
+      sent++;
+      next_send=start+interval*sent;
+    }
+
+    // the remaining time is rounded up, since poll() would otherwise return
+    // immediately and repeatedly during the last millisecond
+
+    const auto until=(sent < count) ? std::min(next_send, end) : end;
+    const auto us=std::chrono::duration_cast<std::chrono::microseconds>(
+      until-now).count();
+    const int timeout=static_cast<int>((std::max<long long>(0, us)+999)/1000);
+
+    if (::poll(fds.data(), fds.size(), timeout) > 0)
+    {
+      for (size_t k=0; k<fds.size(); k++)
+      {
+        if ((fds[k].revents & POLLIN) == 0)
+        {
+          continue;
+        }
+
+        Group &group=*fd_group[k];
+
+        while (true)
+        {
+          uint8_t p[64];
+          sockaddr_ll from;
+          socklen_t from_len=sizeof(from);
+
+          const ssize_t n=::recvfrom(group.fd, p, sizeof(p), 0,
+                                     reinterpret_cast<sockaddr *>(&from), &from_len);
+
+          if (n < 0)
+          {
+            break;
+          }
+
+          // skip own packets and anything that is not ethernet / IPv4
+
+          if (from.sll_pkttype == PACKET_OUTGOING || n < 28 ||
+              p[0] != 0x00 || p[1] != 0x01 || p[2] != 0x08 || p[3] != 0x00 ||
+              p[4] != 6 || p[5] != 4)
+          {
+            continue;
+          }
+
+          const uint64_t sender_mac=toMAC(p+8);
+          const uint32_t sender_ip=toIP(p+14);
+          const uint32_t target_ip=toIP(p+24);
+          const bool request=(p[6] == 0x00 && p[7] == 0x01);
+
+          if (sender_mac == group.iface.mac)
+          {
+            continue;
+          }
+
+          for (size_t i : group.probes)
+          {
+            // the address is used if another host announces it or if
+            // another host probes for it at the same time
+
+            if (!results[i].conflict && sender_mac != probes[i].own_mac &&
+                (sender_ip == probes[i].ip ||
+                 (request && sender_ip == 0 && target_ip == probes[i].ip)))
+            {
+              results[i].conflict=true;
+              results[i].mac=sender_mac;
+            }
+          }
+        }
+      }
+    }
+
+    now=clock::now();
+  }
+
+  return results;
+}
+
+#endif
+
+}
@@ -0,0 +1,94 @@
+/*
+ * rcdiscover - the network discovery tool for Roboception devices
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef RCDISCOVER_ARP_PROBE_H
+#define RCDISCOVER_ARP_PROBE_H
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace rcdiscover
+{
+
+/**
+ * @brief Checks if IP addresses are already in use before they are assigned.
+ *
+ * On Linux, ARP probes according to RFC 5227, i.e. ARP requests with the
+ * sender IP address 0.0.0.0, are sent via AF_PACKET sockets for all
+ * addresses at the same time and all ARP packets are watched within a bounded
+ * time window. An address is in use if any host announces it as sender
+ * address or probes for it at the same time. This requires root privileges
+ * or CAP_NET_RAW. On Windows, SendARP() is used for all addresses in parallel.
+ */
+class ArpProbe
+{
+  public:
+    /**
+     * @brief Address that is probed.
+     */
+    struct Probe
+    {
+      uint32_t ip;        ///< IP address in host byte order
+      std::string iface;  ///< interface, empty for the interface of the subnet
+      uint64_t own_mac;   ///< MAC of the device that should get the address
+    };
+
+    /**
+     * @brief Outcome of probing an address.
+     */
+    struct Result
+    {
+      bool checked;  ///< false if no interface could be found for probing
+      bool conflict; ///< true if the address is used by another host
+      uint64_t mac;  ///< MAC address of the conflicting host
+    };
+
+  public:
+    /**
+     * @brief Probes all addresses at the same time. Answers from the device
+     * that should get an address are not counted as conflict.
+     * @param probes addresses to be probed
+     * @param window time window in milliseconds for probing
+     * @param count number of probes per address within the time window
+     * @return result per probe in the same order as the probes
+     * @throws OperationNotPermitted if raw sockets cannot be opened due to
+     * missing privileges
+     */
+    static std::vector<Result> check(const std::vector<Probe> &probes,
+                                     int window=500, int count=3);
+};
+
+}
+
+#endif // RCDISCOVER_ARP_PROBE_H
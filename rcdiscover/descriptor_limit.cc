@@ -0,0 +1,77 @@
+/*
+ * rcdiscover - the network discovery tool for Roboception devices
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "descriptor_limit.h"
+
+#ifndef WIN32
+#include <sys/resource.h>
+#endif
+
+#include <algorithm>
+
+namespace rcdiscover
+{
+
+bool raiseDescriptorLimit(std::size_t n)
+{
+#ifdef WIN32
+  (void)n;
+  return true;
+#else
+  struct rlimit limit;
+  if (getrlimit(RLIMIT_NOFILE, &limit) != 0)
+  {
+    return false;
+  }
+
+  const rlim_t required=static_cast<rlim_t>(n);
+
+  if (limit.rlim_cur == RLIM_INFINITY || limit.rlim_cur >= required)
+  {
+    return true;
+  }
+
+  if (limit.rlim_max != RLIM_INFINITY)
+  {
+    limit.rlim_cur=std::min(required, limit.rlim_max);
+  }
+  else
+  {
+    limit.rlim_cur=required;
+  }
+
+  return setrlimit(RLIMIT_NOFILE, &limit) == 0 && limit.rlim_cur >= required;
+#endif
+}
+
+}
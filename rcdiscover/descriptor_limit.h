@@ -0,0 +1,58 @@
+/*
+ * rcdiscover - the network discovery tool for Roboception devices
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef RCDISCOVER_DESCRIPTOR_LIMIT_H
+#define RCDISCOVER_DESCRIPTOR_LIMIT_H
+
+#include <cstddef>
+
+namespace rcdiscover
+{
+
+/**
+ * @brief Raises the soft limit of open file descriptors of the process up to
+ * the hard limit, if it is lower than the given number.
+ *
+ * Hosts with hundreds of interfaces need more sockets than the usual default
+ * of 1024 descriptors. The library never changes the limit by itself, since
+ * descriptors above FD_SETSIZE must not be used with select(), e.g. by GUI
+ * toolkits. Applications that do not use select() may call this function at
+ * startup. It does nothing on Windows.
+ * @param n number of required descriptors
+ * @return true if at least n descriptors are available afterwards
+ */
+bool raiseDescriptorLimit(std::size_t n);
+
+}
+
+#endif // RCDISCOVER_DESCRIPTOR_LIMIT_H
@@ -0,0 +1,90 @@
+/*
+ * rcdiscover - the network discovery tool for Roboception devices
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "device_deduplicator.h"
+
+#include <functional>
+#include <algorithm>
+
+namespace rcdiscover
+{
+
+size_t DeviceDeduplicator::KeyHash::operator()(const Key &k) const
+{
+  const size_t h=std::hash<uint64_t>()(k.mac);
+  return h^(std::hash<std::string>()(k.iface)+0x9e3779b9+(h<<6)+(h>>2));
+}
+
+DeviceDeduplicator::Result DeviceDeduplicator::add(const DeviceInfo &info)
+{
+  Key key;
+  key.mac=info.getMAC();
+  key.iface=info.getIfaceName();
+
+  auto ret=index_.emplace(std::move(key), devices_.size());
+
+  if (ret.second)
+  {
+    devices_.push_back(info);
+    return New;
+  }
+
+  DeviceInfo &stored=devices_[ret.first->second];
+
+  if (stored.hasSameContent(info))
+  {
+    return Duplicate;
+  }
+
+  // keep the round and round trip time of the first response
+
+  const int round=stored.getRound();
+  const int rtt=stored.getRTT();
+  stored=info;
+
+  if (round <= info.getRound())
+  {
+    stored.setRound(round);
+    stored.setRTT(rtt);
+  }
+
+  return Changed;
+}
+
+void DeviceDeduplicator::clear()
+{
+  index_.clear();
+  devices_.clear();
+}
+
+}
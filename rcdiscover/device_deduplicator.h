@@ -0,0 +1,109 @@
+/*
+ * rcdiscover - the network discovery tool for Roboception devices
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef RCDISCOVER_DEVICE_DEDUPLICATOR
+#define RCDISCOVER_DEVICE_DEDUPLICATOR
+
+#include "deviceinfo.h"
+
+#include <vector>
+#include <string>
+#include <unordered_map>
+#include <cstdint>
+
+namespace rcdiscover
+{
+
+class DeviceDeduplicator
+{
+  public:
+
+    enum Result
+    {
+      New,
+      Duplicate,
+      Changed
+    };
+
+    /**
+      Adds a discovery response. Responses are identified by MAC address and
+      interface name. Insertion is done in constant time, so that responses
+      can be processed as they arrive.
+
+      @param info Response.
+      @return     New if there was no response of the device on this
+                  interface before, Duplicate if there was a response with the
+                  same information and Changed if the information differs,
+                  e.g. because the IP address has changed. In the last case,
+                  the stored information is replaced.
+    */
+
+    Result add(const DeviceInfo &info);
+
+    /**
+      Returns all distinct responses in the order of their first arrival.
+
+      @return List of responses.
+    */
+
+    const std::vector<DeviceInfo> &getDevices() const { return devices_; }
+
+    /**
+      Removes all responses.
+    */
+
+    void clear();
+
+  private:
+
+    struct Key
+    {
+      uint64_t mac;
+      std::string iface;
+
+      bool operator==(const Key &k) const
+      { return mac == k.mac && iface == k.iface; }
+    };
+
+    struct KeyHash
+    {
+      size_t operator()(const Key &k) const;
+    };
+
+    std::unordered_map<Key, size_t, KeyHash> index_;
+    std::vector<DeviceInfo> devices_;
+};
+
+}
+
+#endif
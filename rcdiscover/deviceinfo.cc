@@ -35,91 +35,55 @@
 
 #include "deviceinfo.h"
 
-#include <sstream>
+#include "deviceinfo_view.h"
 
-namespace rcdiscover
-{
-
-namespace
-{
-
-/*
-  Extract at most len bytes from p as characters and returns them as string.
-  Extraction ends if a null byte is encountered or if len bytes have been
-  extracted.
-
-  @param p   Pointer to byte array.
-  @param len Maximum number of bytes to extract.
-  @return    Extracted string.
-*/
+#include <cstring>
 
-std::string extract(const uint8_t *p, size_t len)
+namespace rcdiscover
 {
-  std::ostringstream out;
-
-  while (*p != 0 && len > 0)
-  {
-    out << static_cast<char>(*p);
-
-    p++;
-    len--;
-  }
-
-  return out.str();
-}
-
-}
 
 DeviceInfo::DeviceInfo(std::string iface_name) :
-    iface_name(std::move(iface_name))
+    iface_name(std::move(iface_name)),
+    round(1),
+    rtt(-1)
 {
   clear();
 }
 
 void DeviceInfo::set(const uint8_t *raw, size_t len)
 {
-  // clear stored information
-
-  clear();
-
-  // extract information
-
-  if (len >= 4)
-  {
-    major=(static_cast<int>(raw[0])<<8)|raw[1];
-    minor=(static_cast<int>(raw[2])<<8)|raw[3];
-  }
-
-  if (len >= 16)
-  {
-    mac=0;
-    for (int i=0; i<6; i++) mac=(mac<<8)|raw[10+i];
-  }
-
-  if (len >= 40)
-  {
-    ip=0;
-    for (int i=0; i<4; i++) ip=(ip<<8)|raw[36+i];
-  }
-
-  if (len >= 56)
-  {
-    subnet=0;
-    for (int i=0; i<4; i++) subnet=(subnet<<8)|raw[52+i];
-  }
+  set(DeviceInfoView(raw, len));
+}
 
-  if (len >= 72)
-  {
-    gateway=0;
-    for (int i=0; i<4; i++) gateway=(gateway<<8)|raw[68+i];
-  }
+void DeviceInfo::set(const DeviceInfoView &view)
+{
+  major=view.getMajorVersion();
+  minor=view.getMinorVersion();
+
+  mac=view.getMAC();
+  ip=view.getIP();
+  subnet=view.getSubnetMask();
+  gateway=view.getGateway();
+
+  view.copyString(72, 32, manufacturer_name);
+  view.copyString(104, 32, model_name);
+  view.copyString(136, 32, device_version);
+  view.copyString(168, 48, manufacturer_info);
+  view.copyString(216, 16, serial_number);
+  view.copyString(232, 16, user_name);
+}
 
-  if (len >= 104) manufacturer_name=extract(raw+72, 32);
-  if (len >= 136) model_name=extract(raw+104, 32);
-  if (len >= 168) device_version=extract(raw+136, 32);
-  if (len >= 216) manufacturer_info=extract(raw+168, 48);
-  if (len >= 232) serial_number=extract(raw+216, 16);
-  if (len >= 248) user_name=extract(raw+232, 16);
+bool DeviceInfo::hasSameContent(const DeviceInfo &info) const
+{
+  return mac == info.mac && iface_name == info.iface_name &&
+    major == info.major && minor == info.minor &&
+    ip == info.ip && subnet == info.subnet && gateway == info.gateway &&
+    strcmp(manufacturer_name, info.manufacturer_name) == 0 &&
+    strcmp(model_name, info.model_name) == 0 &&
+    strcmp(device_version, info.device_version) == 0 &&
+    strcmp(manufacturer_info, info.manufacturer_info) == 0 &&
+    strcmp(serial_number, info.serial_number) == 0 &&
+    strcmp(user_name, info.user_name) == 0;
 }
 
 void DeviceInfo::clear()
@@ -130,12 +94,12 @@ void DeviceInfo::clear()
   subnet=0;
   gateway=0;
 
-  manufacturer_name.erase();
-  model_name.erase();
-  device_version.erase();
-  manufacturer_info.erase();
-  serial_number.erase();
-  user_name.erase();
+  manufacturer_name[0]='\0';
+  model_name[0]='\0';
+  device_version[0]='\0';
+  manufacturer_info[0]='\0';
+  serial_number[0]='\0';
+  user_name[0]='\0';
 }
 
 }
\ No newline at end of file
@@ -43,6 +43,17 @@
 namespace rcdiscover
 {
 
+class DeviceInfoView;
+
+/**
+  Information about a device as reported in its DISCOVERY_ACK.
+
+  The string fields of the package are stored in fixed size arrays inside
+  the object, so that storing or setting a device info does not allocate.
+  Therefore, the string getters return a std::string by value, which is
+  built from the field on each call, instead of a reference to a member.
+*/
+
 class DeviceInfo
 {
   public:
@@ -59,6 +70,14 @@ class DeviceInfo
 
     void set(const uint8_t *raw, size_t len);
 
+    /**
+      Copies all information from the given view on a DISCOVERY_ACK package.
+
+      @param view View on the message body.
+    */
+
+    void set(const DeviceInfoView &view);
+
     /**
       Clears all information.
     */
@@ -122,50 +141,96 @@ class DeviceInfo
     /**
       Returns the manufacturer name.
 
-      @return Manufacturer name.
+      @return Manufacturer name, built on demand.
     */
 
-    const std::string &getManufacturerName() const { return manufacturer_name; }
+    std::string getManufacturerName() const { return manufacturer_name; }
 
     /**
       Returns the model name.
 
-      @return Model name.
+      @return Model name, built on demand.
     */
 
-    const std::string &getModelName() const { return model_name; }
+    std::string getModelName() const { return model_name; }
 
     /**
       Returns the device version.
 
-      @return Device version.
+      @return Device version, built on demand.
     */
 
-    const std::string &getDeviceVersion() const { return device_version; }
+    std::string getDeviceVersion() const { return device_version; }
 
     /**
       Returns manufacturer specific information.
 
-      @return Manufacturer info.
+      @return Manufacturer info, built on demand.
     */
 
-    const std::string &getManufacturerInfo() const { return manufacturer_info; }
+    std::string getManufacturerInfo() const { return manufacturer_info; }
 
     /**
       Returns the serial number.
 
-      @return Serial number.
+      @return Serial number, built on demand.
     */
 
-    const std::string &getSerialNumber() const { return serial_number; }
+    std::string getSerialNumber() const { return serial_number; }
 
     /**
       Returns the user name.
 
-      @return User name.
+      @return User name, built on demand.
+    */
+
+    std::string getUserName() const { return user_name; }
+
+    /**
+      Sets the discovery round in which the device has answered.
+
+      @param r Round, starting with 1 for the first request.
+    */
+
+    void setRound(int r) { round=r; }
+
+    /**
+      Returns the discovery round in which the device has answered, i.e. 1
+      for an answer to the first request, 2 for an answer to the first
+      retransmission, etc.
+
+      @return Round.
     */
 
-    const std::string &getUserName() const { return user_name; }
+    int getRound() const { return round; }
+
+    /**
+      Sets the round trip time of the request to which the device has
+      answered.
+
+      @param us Time in microseconds or -1 if unknown.
+    */
+
+    void setRTT(int us) { rtt=us; }
+
+    /**
+      Returns the time between sending the request and receiving the answer
+      of the device.
+
+      @return Round trip time in microseconds or -1 if unknown.
+    */
+
+    int getRTT() const { return rtt; }
+
+    /**
+      Compares all information, including the interface name, but except
+      the discovery round and the round trip time.
+
+      @param info Other device info.
+      @return     True if all information is the same.
+    */
+
+    bool hasSameContent(const DeviceInfo &info) const;
 
     /**
      * First compares the MAC address, then the interface name.
@@ -182,6 +247,8 @@ class DeviceInfo
   private:
 
     std::string iface_name;
+    int round;
+    int rtt;
 
     int major;
     int minor;
@@ -191,12 +258,14 @@ class DeviceInfo
     uint32_t subnet;
     uint32_t gateway;
 
-    std::string manufacturer_name;
-    std::string model_name;
-    std::string device_version;
-    std::string manufacturer_info;
-    std::string serial_number;
-    std::string user_name;
+    // fixed size fields as in the DISCOVERY_ACK with null termination
+
+    char manufacturer_name[32+1];
+    char model_name[32+1];
+    char device_version[32+1];
+    char manufacturer_info[48+1];
+    char serial_number[16+1];
+    char user_name[16+1];
 };
 
 }
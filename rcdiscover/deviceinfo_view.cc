@@ -0,0 +1,129 @@
+/*
+ * rcdiscover - the network discovery tool for Roboception devices
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "deviceinfo_view.h"
+
+#include <cstring>
+
+namespace rcdiscover
+{
+
+DeviceInfoView::DeviceInfoView(const uint8_t *raw, size_t len) :
+  raw_(raw), len_(len)
+{ }
+
+int DeviceInfoView::getMajorVersion() const
+{
+  if (len_ < 4) return 0;
+  return (static_cast<int>(raw_[0])<<8)|raw_[1];
+}
+
+int DeviceInfoView::getMinorVersion() const
+{
+  if (len_ < 4) return 0;
+  return (static_cast<int>(raw_[2])<<8)|raw_[3];
+}
+
+uint64_t DeviceInfoView::getMAC() const
+{
+  if (len_ < 16) return 0;
+
+  uint64_t mac=0;
+  for (int i=0; i<6; i++) mac=(mac<<8)|raw_[10+i];
+
+  return mac;
+}
+
+uint32_t DeviceInfoView::getUInt32(size_t offset) const
+{
+  if (len_ < offset+4) return 0;
+
+  uint32_t ret=0;
+  for (int i=0; i<4; i++) ret=(ret<<8)|raw_[offset+i];
+
+  return ret;
+}
+
+namespace
+{
+
+/*
+  Returns the length of a string field, which ends with a null byte, unless
+  it uses the complete field.
+*/
+
+inline size_t fieldLength(const uint8_t *p, size_t len)
+{
+  const void *end=memchr(p, 0, len);
+
+  if (end != 0)
+  {
+    len=static_cast<size_t>(static_cast<const uint8_t *>(end)-p);
+  }
+
+  return len;
+}
+
+}
+
+std::string DeviceInfoView::getString(size_t offset, size_t len) const
+{
+  // fields are only taken if the complete field is contained in the package
+
+  if (len_ < offset+len) return std::string();
+
+  const uint8_t *p=raw_+offset;
+  return std::string(reinterpret_cast<const char *>(p), fieldLength(p, len));
+}
+
+void DeviceInfoView::copyString(size_t offset, size_t len, char *dest) const
+{
+  size_t n=0;
+
+  if (len_ >= offset+len)
+  {
+    n=fieldLength(raw_+offset, len);
+    memcpy(dest, raw_+offset, n);
+  }
+
+  dest[n]='\0';
+}
+
+DeviceInfo DeviceInfoView::toDeviceInfo(std::string iface_name) const
+{
+  DeviceInfo ret(std::move(iface_name));
+  ret.set(*this);
+  return ret;
+}
+
+}
@@ -0,0 +1,193 @@
+/*
+ * rcdiscover - the network discovery tool for Roboception devices
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef RCDISCOVER_DEVICEINFO_VIEW
+#define RCDISCOVER_DEVICEINFO_VIEW
+
+#include "deviceinfo.h"
+
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+namespace rcdiscover
+{
+
+class DeviceInfoView
+{
+  public:
+
+    /**
+      Creates a non-owning view on the body of a DISCOVERY_ACK package.
+      Fields are read from the buffer on demand. The buffer must stay valid
+      and unchanged as long as the view is used.
+
+      @param raw Pointer to raw message body, excluding header.
+      @param len Length of body as specified in the header.
+    */
+
+    DeviceInfoView(const uint8_t *raw, size_t len);
+
+    /**
+      Checks if the package contains useful information.
+    */
+
+    bool isValid() const { return getMAC() != 0; }
+
+    /**
+      Return major version of device.
+
+      @return Major version.
+    */
+
+    int getMajorVersion() const;
+
+    /**
+      Return minor version of device.
+
+      @return Minor version.
+    */
+
+    int getMinorVersion() const;
+
+    /**
+      Returns the MAC address of the device.
+
+      @return 6 bytes with the MAC address.
+    */
+
+    uint64_t getMAC() const;
+
+    /**
+      Returns the current IP address of the device.
+
+      @return 4 bytes with an IPv4 address.
+    */
+
+    uint32_t getIP() const { return getUInt32(36); }
+
+    /**
+      Returns the current subnet mask of the device.
+
+      @return 4 bytes with an IPv4 subnet mask.
+    */
+
+    uint32_t getSubnetMask() const { return getUInt32(52); }
+
+    /**
+      Returns the current IP address of the devices gateway.
+
+      @return 4 bytes with an IPv4 address.
+    */
+
+    uint32_t getGateway() const { return getUInt32(68); }
+
+    /**
+      Returns the manufacturer name.
+
+      @return Manufacturer name.
+    */
+
+    std::string getManufacturerName() const { return getString(72, 32); }
+
+    /**
+      Returns the model name.
+
+      @return Model name.
+    */
+
+    std::string getModelName() const { return getString(104, 32); }
+
+    /**
+      Returns the device version.
+
+      @return Device version.
+    */
+
+    std::string getDeviceVersion() const { return getString(136, 32); }
+
+    /**
+      Returns manufacturer specific information.
+
+      @return Manufacturer info.
+    */
+
+    std::string getManufacturerInfo() const { return getString(168, 48); }
+
+    /**
+      Returns the serial number.
+
+      @return Serial number.
+    */
+
+    std::string getSerialNumber() const { return getString(216, 16); }
+
+    /**
+      Returns the user name.
+
+      @return User name.
+    */
+
+    std::string getUserName() const { return getString(232, 16); }
+
+    /**
+      Copies all information into a device info object.
+
+      @param iface_name Name of the interface on which the package has been
+                        received.
+      @return           Device info.
+    */
+
+    DeviceInfo toDeviceInfo(std::string iface_name) const;
+
+  private:
+
+    friend class DeviceInfo;
+
+    uint32_t getUInt32(size_t offset) const;
+    std::string getString(size_t offset, size_t len) const;
+
+    /**
+      Copies a string field with null termination into the given array of
+      len+1 bytes.
+    */
+
+    void copyString(size_t offset, size_t len, char *dest) const;
+
+    const uint8_t *raw_;
+    size_t len_;
+};
+
+}
+
+#endif
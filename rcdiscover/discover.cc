@@ -35,8 +35,8 @@
 
 #include "discover.h"
 
+#include "deviceinfo_view.h"
 #include "socket_exception.h"
-#include "gige_request_counter.h"
 
 #include <exception>
 #include <ios>
@@ -52,10 +52,12 @@
 #include <arpa/inet.h>
 #include <unistd.h>
 #include <fcntl.h>
+#include <net/if.h>
+#include <netinet/in.h>
 #endif
 
 #include <vector>
-#include <future>
+#include <chrono>
 #include <string.h>
 #include <errno.h>
 #include <algorithm>
@@ -69,14 +71,157 @@ typedef SocketWindows SocketImpl;
 typedef SocketLinux SocketImpl;
 #endif
 
-Discover::Discover() :
-  sockets_(SocketType::createAndBindForAllInterfaces(3956))
+namespace
 {
-  for (auto &socket : sockets_)
+
+const size_t max_package_size=600;
+const unsigned int batch_size=32;
+
+}
+
+/*
+  Preallocated ring of receive buffers for reading a batch of packets with
+  one system call.
+*/
+
+struct Discover::ReceiveBuffer
+{
+  std::vector<uint8_t> data;
+  std::vector<long> len;
+  std::vector<struct sockaddr_in> addr;
+
+#ifndef WIN32
+  std::vector<struct iovec> iov;
+  std::vector<struct mmsghdr> msg;
+  std::vector<char> control;
+#endif
+
+  ReceiveBuffer() : data(batch_size*max_package_size), len(batch_size),
+    addr(batch_size)
+  {
+#ifndef WIN32
+    iov.resize(batch_size);
+    msg.resize(batch_size);
+    control.resize(batch_size*CMSG_SPACE(sizeof(struct in_pktinfo)));
+#endif
+  }
+
+  const uint8_t *get(unsigned int i) const
+  {
+    return data.data()+i*max_package_size;
+  }
+
+  /*
+    Returns the name of the interface on which the given packet has been
+    received. This requires IP_PKTINFO to be enabled on Linux.
+  */
+
+  std::string getIfaceName(unsigned int i)
   {
-    socket.enableBroadcast();
-    socket.enableNonBlocking();
+#ifdef WIN32
+    return SocketWindows::getIfaceNameForAddr(addr[i].sin_addr.s_addr);
+#else
+    for (struct cmsghdr *cmsg=CMSG_FIRSTHDR(&msg[i].msg_hdr); cmsg != 0;
+         cmsg=CMSG_NXTHDR(&msg[i].msg_hdr, cmsg))
+    {
+      if (cmsg->cmsg_level == IPPROTO_IP && cmsg->cmsg_type == IP_PKTINFO)
+      {
+        struct in_pktinfo info;
+        memcpy(&info, CMSG_DATA(cmsg), sizeof(info));
+
+        char name[IF_NAMESIZE];
+        if (if_indextoname(static_cast<unsigned int>(info.ipi_ifindex), name) != 0)
+        {
+          return std::string(name);
+        }
+      }
+    }
+
+    return std::string();
+#endif
   }
+
+  /*
+    Reads up to batch_size queued packets from the given non-blocking socket.
+
+    @return Number of packets that have been read.
+  */
+
+  unsigned int receive(Discover::SocketType &socket)
+  {
+    auto sock = socket.getHandle<typename Discover::SocketType::SocketType>();
+
+#ifdef WIN32
+    unsigned int n=0;
+    while (n < batch_size)
+    {
+      int naddr=sizeof(addr[n]);
+      int ret=recvfrom(sock, reinterpret_cast<char *>(data.data()+n*max_package_size),
+                       static_cast<int>(max_package_size), 0,
+                       reinterpret_cast<struct sockaddr *>(&addr[n]), &naddr);
+
+      if (ret < 0)
+      {
+        break;
+      }
+
+      len[n++]=ret;
+    }
+
+    return n;
+#else
+    const size_t ncontrol=CMSG_SPACE(sizeof(struct in_pktinfo));
+
+    for (unsigned int i=0; i<batch_size; i++)
+    {
+      iov[i].iov_base=data.data()+i*max_package_size;
+      iov[i].iov_len=max_package_size;
+
+      memset(&msg[i], 0, sizeof(msg[i]));
+      msg[i].msg_hdr.msg_name=&addr[i];
+      msg[i].msg_hdr.msg_namelen=sizeof(addr[i]);
+      msg[i].msg_hdr.msg_iov=&iov[i];
+      msg[i].msg_hdr.msg_iovlen=1;
+      msg[i].msg_hdr.msg_control=control.data()+i*ncontrol;
+      msg[i].msg_hdr.msg_controllen=ncontrol;
+    }
+
+    int ret=recvmmsg(sock, msg.data(), batch_size, 0, NULL);
+
+    if (ret <= 0)
+    {
+      return 0;
+    }
+
+    for (int i=0; i<ret; i++)
+    {
+      len[i]=static_cast<long>(msg[i].msg_len);
+    }
+
+    return static_cast<unsigned int>(ret);
+#endif
+  }
+};
+
+Discover::Discover(SocketMode mode, const InterfaceFilter &filter) :
+  Discover(std::make_shared<InterfaceCache>(3956, mode, filter))
+{ }
+
+Discover::Discover(std::shared_ptr<InterfaceCache> cache) :
+  cache_(std::move(cache)),
+  sockets_(cache_->getSockets()),
+  generation_(0),
+  buffer_(new ReceiveBuffer()),
+  retransmits_(0),
+  retransmit_interval_(0),
+  broadcast_round_(0),
+  sweep_in_flight_(0),
+  sweep_serial_(0),
+  sweep_window_(0),
+  sweep_interval_(0),
+  sweep_timeout_(0)
+{
+  registerSockets();
 }
 
 Discover::~Discover()
@@ -84,118 +229,501 @@ Discover::~Discover()
 
 void Discover::broadcastRequest()
 {
-  req_nums_.clear();
+  requests_.clear(RequestTable::Broadcast);
+  broadcast_round_=0;
+
+  cache_->update();
+  registerSockets();
+
+  sendBroadcast(std::chrono::steady_clock::now());
+}
+
+void Discover::setRetransmits(int count, int interval)
+{
+  retransmits_=std::max(0, count);
+  retransmit_interval_=std::chrono::milliseconds(std::max(1, interval));
+}
+
+void Discover::registerSockets()
+{
+  if (generation_ == cache_->getGeneration())
+  {
+    return;
+  }
+
+  reactor_.clear();
+
+  for (size_t i=0; i<sockets_.size(); i++)
+  {
+    reactor_.add(sockets_[i].getHandle<typename SocketType::SocketType>(), i);
+  }
+
+  // the id of the unicast socket follows the interface sockets
+
+  if (unicast_socket_)
+  {
+    reactor_.add(unicast_socket_->getHandle<typename SocketType::SocketType>(),
+                 sockets_.size());
+
+    // requests in flight are directly indexed by their request id
+
+    sweep_slots_.resize(65536);
+    for (auto &slot : sweep_slots_)
+    {
+      slot.serial=0;
+    }
+  }
+
+  generation_=cache_->getGeneration();
+}
+
+void Discover::sendBroadcast(std::chrono::steady_clock::time_point now)
+{
+  broadcast_round_++;
 
   std::vector<uint8_t> discovery_cmd{0x42, 0x11, 0, 0x02, 0, 0, 0, 0};
 
-  for (auto &socket : sockets_)
+  for (size_t i=0; i<sockets_.size(); i++)
   {
-    req_nums_.push_back(GigERequestCounter::getNext());
-    std::tie(discovery_cmd[6], discovery_cmd[7]) = req_nums_.back();
+    const uint16_t id=requests_.add(RequestTable::Broadcast, broadcast_round_);
+    discovery_cmd[6]=static_cast<uint8_t>(id>>8);
+    discovery_cmd[7]=static_cast<uint8_t>(id);
 
     try
     {
-      socket.send(discovery_cmd);
+      sockets_[i].send(discovery_cmd);
     }
     catch(const NetworkUnreachableException &)
     {
       continue;
     }
   }
+
+  // exponential backoff for the next retransmission
+
+  if (broadcast_round_ <= retransmits_)
+  {
+    broadcast_next_=now+retransmit_interval_*(1 << std::min(broadcast_round_-1, 16));
+  }
+}
+
+void Discover::sweepRequest(const std::vector<uint32_t> &ip, int window,
+                            int rate, int timeout)
+{
+  if (!unicast_socket_)
+  {
+    // socket for unicast requests to all interfaces, which reports the
+    // interface on which responses are received
+
+    unicast_socket_.reset(new SocketType(SocketType::create(0, 3956, "")));
+
+    sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = 0;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    unicast_socket_->bind(addr);
+    unicast_socket_->enableNonBlocking();
+
+#ifndef WIN32
+    const int yes=1;
+    if (setsockopt(unicast_socket_->getHandle<typename SocketType::SocketType>(),
+                   IPPROTO_IP, IP_PKTINFO, &yes, sizeof(yes)) == -1)
+    {
+      throw SocketException("Error while setting socket options", errno);
+    }
+#endif
+
+    reactor_.add(unicast_socket_->getHandle<typename SocketType::SocketType>(),
+                 sockets_.size());
+
+    // requests in flight are directly indexed by their request id
+
+    sweep_slots_.resize(65536);
+    for (auto &slot : sweep_slots_)
+    {
+      slot.serial=0;
+    }
+  }
+
+  for (uint32_t a : ip)
+  {
+    SweepRequest request;
+    request.ip=a;
+    request.round=1;
+    request.serial=0;
+    sweep_queue_.push_back(request);
+  }
+
+  sweep_window_=static_cast<std::size_t>(std::max(1, window));
+  sweep_interval_=std::chrono::microseconds(1000000/std::max(1, rate));
+  sweep_timeout_=std::chrono::milliseconds(std::max(0, timeout));
+  sweep_next_send_=std::chrono::steady_clock::now();
+}
+
+bool Discover::hasPendingRequests() const
+{
+  return (broadcast_round_ > 0 && broadcast_round_ <= retransmits_) ||
+    !sweep_queue_.empty() || sweep_in_flight_ > 0;
 }
 
 bool Discover::getResponse(std::vector<DeviceInfo> &info,
                            int timeout_per_socket)
 {
-  // setup waiting for data to arrive
+  // wait for data until a valid package arrives or the timeout is reached
 
-  struct timeval tv;
-  tv.tv_sec=timeout_per_socket/1000;
-  tv.tv_usec=(timeout_per_socket%1000)*1000;
+  const std::chrono::steady_clock::time_point tend=std::chrono::steady_clock::now()+
+    std::chrono::milliseconds(timeout_per_socket);
 
-  // try to get a valid package (repeat if an invalid package is received)
-
-  const auto &req_nums = req_nums_;
+  bool ret=false;
+  int timeout=timeout_per_socket;
 
-  std::vector<std::future<DeviceInfo>> futures;
-  for (auto &socket : sockets_)
+  while (!ret && timeout >= 0)
   {
-    futures.push_back(std::async(std::launch::async, [&socket, &tv, &req_nums]
+    waitForData(timeout);
+
+    for (std::size_t i : ready_)
     {
-      DeviceInfo device_info(socket.getIfaceName());
-      device_info.clear();
+      if (i >= sockets_.size())
+      {
+        ret|=drainResponses(getSocket(i), info);
+        continue;
+      }
 
-      int count = 10;
+      DeviceInfo device_info(sockets_[i].getIfaceName());
 
-      auto sock = socket.getHandle<typename SocketType::SocketType>();
+      if (receiveResponse(sockets_[i], device_info))
+      {
+        info.push_back(device_info);
+        ret=true;
+      }
+    }
 
-      fd_set fds;
-      FD_ZERO(&fds);
-      FD_SET(sock, &fds);
+    timeout=static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(
+      tend-std::chrono::steady_clock::now()).count());
+  }
 
-      while (!device_info.isValid() && count > 0)
-      {
-        count--;
+  return ret;
+}
 
-        if (select(static_cast<int>(sock+1), &fds, NULL, NULL, &tv) > 0)
-        {
-          // get package
+bool Discover::receiveResponse(SocketType &socket, DeviceInfo &device_info)
+{
+  auto sock = socket.getHandle<typename SocketType::SocketType>();
+
+  // try to get a valid package (repeat if an invalid package is received)
 
-          uint8_t p[600];
+  int count = 10;
 
-          struct sockaddr_in addr;
+  while (!device_info.isValid() && count > 0)
+  {
+    count--;
+
+    // get package
+
+    uint8_t p[600];
+
+    struct sockaddr_in addr;
 #ifdef WIN32
-          int naddr = sizeof(addr);
+    int naddr = sizeof(addr);
 #else
-          socklen_t naddr = sizeof(addr);
+    socklen_t naddr = sizeof(addr);
 #endif
-          memset(&addr, 0, naddr);
+    memset(&addr, 0, naddr);
 
-          long n = recvfrom(sock,
-                            reinterpret_cast<char *>(p), sizeof(p), 0,
-                            reinterpret_cast<struct sockaddr *>(&addr), &naddr);
+    long n = recvfrom(sock,
+                      reinterpret_cast<char *>(p), sizeof(p), 0,
+                      reinterpret_cast<struct sockaddr *>(&addr), &naddr);
+
+    if (n < 0)
+    {
+      // no more data available on this non-blocking socket
+
+      break;
+    }
 
-          // check if received package is a valid discovery acknowledge
+    // check if received package is a valid discovery acknowledge
 
-          if (n >= 8)
+    int round=0, rtt=-1;
+    size_t len=checkAcknowledge(p, n, round, rtt);
+
+    if (len > 0)
+    {
+      // extract information and store in list
+
+      device_info.set(p+8, len);
+      device_info.setRound(round);
+      device_info.setRTT(rtt);
+    }
+  }
+
+  return device_info.isValid();
+}
+
+std::vector<std::string> Discover::getInterfaceNames() const
+{
+  return cache_->getInterfaceNames();
+}
+
+bool Discover::getAllResponses(std::vector<DeviceInfo> &info, int timeout)
+{
+  // wait for data until a valid package arrives or the timeout is reached
+
+  const std::chrono::steady_clock::time_point tend=std::chrono::steady_clock::now()+
+    std::chrono::milliseconds(timeout);
+
+  bool ret=false;
+
+  while (!ret && timeout >= 0)
+  {
+    waitForData(timeout);
+
+    for (std::size_t i : ready_)
+    {
+      ret|=drainResponses(getSocket(i), info);
+    }
+
+    timeout=static_cast<int>(std::chrono::duration_cast<std::chrono::milliseconds>(
+      tend-std::chrono::steady_clock::now()).count());
+  }
+
+  return ret;
+}
+
+bool Discover::drainResponses(SocketType &socket, std::vector<DeviceInfo> &info)
+{
+  const bool unicast=(&socket == unicast_socket_.get());
+  bool ret=false;
+
+  // read batches until the socket has no more queued packets
+
+  unsigned int n=batch_size;
+  while (n == batch_size)
+  {
+    n=buffer_->receive(socket);
+
+    for (unsigned int i=0; i<n; i++)
+    {
+      const uint8_t *p=buffer_->get(i);
+      int round=0, rtt=-1;
+      size_t len=checkAcknowledge(p, buffer_->len[i], round, rtt);
+
+      if (len > 0)
+      {
+        if (unicast)
+        {
+          SweepRequest &slot=sweep_slots_[static_cast<uint16_t>((p[6]<<8)|p[7])];
+
+          if (slot.serial != 0)
           {
-            if (p[0] == 0 && p[1] == 0 && p[2] == 0 &&
-                p[3] == 0x03)
-            {
-              if (std::find(req_nums.begin(), req_nums.end(),
-                            std::make_tuple(p[6], p[7])) != req_nums.end())
-              {
-                size_t len=(static_cast<size_t>(p[4])<<8)|p[5];
-
-                if (static_cast<size_t>(n) >= len+8)
-                {
-                  // extract information and store in list
-
-                  device_info.set(p+8, len);
-                }
-              }
-            }
+            slot.serial=0;
+            sweep_in_flight_--;
           }
         }
-        else
+
+        // only copy the information of valid responses
+
+        DeviceInfoView view(p+8, len);
+
+        if (view.isValid())
         {
-          count=0;
+          info.push_back(view.toDeviceInfo(unicast ? buffer_->getIfaceName(i) :
+                                                     socket.getIfaceName()));
+          info.back().setRound(round);
+          info.back().setRTT(rtt);
+          ret=true;
         }
       }
+    }
+  }
 
-      return device_info;
-    }));
+  return ret;
+}
 
+size_t Discover::checkAcknowledge(const uint8_t *p, long n, int &round,
+                                  int &rtt) const
+{
+  if (n >= 8)
+  {
+    if (p[0] == 0 && p[1] == 0 && p[2] == 0 &&
+        p[3] == 0x03)
+    {
+      const uint16_t id=static_cast<uint16_t>((p[6]<<8)|p[7]);
+
+      RequestTable::Request request;
+      if (requests_.find(id, request))
+      {
+        round=request.round;
+        rtt=static_cast<int>(std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::steady_clock::now()-request.sent).count());
+
+        size_t len=(static_cast<size_t>(p[4])<<8)|p[5];
+
+        if (static_cast<size_t>(n) >= len+8)
+        {
+          return len;
+        }
+      }
+    }
   }
 
-  bool ret = false;
-  for (auto &f : futures)
+  return 0;
+}
+
+void Discover::waitForData(int timeout)
+{
+  // sockets may have been recreated by another user of the cache
+
+  registerSockets();
+
+  reactor_.wait(ready_, pumpRequests(timeout));
+}
+
+int Discover::pumpRequests(int timeout)
+{
+  if (!hasPendingRequests())
   {
-    info.push_back(f.get());
-    ret |= info.back().isValid();
+    return timeout;
   }
 
-  return ret;
+  const std::chrono::steady_clock::time_point now=std::chrono::steady_clock::now();
+  std::chrono::steady_clock::time_point next=now+std::chrono::milliseconds(timeout);
+
+  // retransmission of broadcast request
+
+  if (broadcast_round_ > 0 && broadcast_round_ <= retransmits_)
+  {
+    if (broadcast_next_ <= now)
+    {
+      sendBroadcast(now);
+    }
+
+    if (broadcast_round_ <= retransmits_)
+    {
+      next=std::min(next, broadcast_next_);
+    }
+  }
+
+  // unanswered requests do not count as in flight after their timeout, but
+  // are retransmitted if requested. The timeout only depends on the round,
+  // so that the requests of each round expire in the order of sending.
+  // Answered requests are dropped from the front of the queues on the way.
+
+  for (auto &expiry : sweep_expiry_)
+  {
+    while (!expiry.empty())
+    {
+      SweepRequest &slot=sweep_slots_[expiry.front().id];
+
+      if (slot.serial == expiry.front().serial)
+      {
+        if (slot.expiry > now)
+        {
+          break;
+        }
+
+        if (slot.round <= retransmits_)
+        {
+          SweepRequest request=slot;
+          request.round++;
+          request.serial=0;
+          sweep_queue_.push_front(request);
+        }
+
+        slot.serial=0;
+        sweep_in_flight_--;
+      }
+
+      expiry.pop_front();
+    }
+  }
+
+  // allow sending a burst of at most one millisecond for catching up
+
+  if (sweep_next_send_ < now-std::chrono::milliseconds(1))
+  {
+    sweep_next_send_=now-std::chrono::milliseconds(1);
+  }
+
+  std::vector<uint8_t> discovery_cmd{0x42, 0x01, 0, 0x02, 0, 0, 0, 0};
+
+  while (!sweep_queue_.empty() && sweep_in_flight_ < sweep_window_ &&
+         sweep_next_send_ <= now)
+  {
+    SweepRequest request=sweep_queue_.front();
+
+    const uint16_t id=requests_.add(RequestTable::Unicast, request.round);
+    discovery_cmd[6]=static_cast<uint8_t>(id>>8);
+    discovery_cmd[7]=static_cast<uint8_t>(id);
+
+    try
+    {
+      unicast_socket_->sendTo(discovery_cmd, request.ip);
+
+      SweepRequest &slot=sweep_slots_[id];
+
+      if (slot.serial != 0)
+      {
+        // request id has wrapped around, forget the old request
+
+        sweep_in_flight_--;
+      }
+
+      if (++sweep_serial_ == 0)
+      {
+        sweep_serial_=1;
+      }
+
+      request.expiry=now+sweep_timeout_*(1 << std::min(request.round-1, 16));
+      request.serial=sweep_serial_;
+      slot=request;
+      sweep_in_flight_++;
+
+      if (sweep_expiry_.size() < static_cast<std::size_t>(request.round))
+      {
+        sweep_expiry_.resize(static_cast<std::size_t>(request.round));
+      }
+
+      SweepExpiry expiry;
+      expiry.id=id;
+      expiry.serial=request.serial;
+      sweep_expiry_[request.round-1].push_back(expiry);
+    }
+    catch (const SocketException &)
+    {
+      // address is not reachable, continue with next one
+    }
+
+    sweep_queue_.pop_front();
+    sweep_next_send_+=sweep_interval_;
+  }
+
+  // determine time of next send or expiry of a request
+
+  if (!sweep_queue_.empty() && sweep_in_flight_ < sweep_window_)
+  {
+    next=std::min(next, sweep_next_send_);
+  }
+
+  for (const auto &expiry : sweep_expiry_)
+  {
+    if (!expiry.empty())
+    {
+      next=std::min(next, sweep_slots_[expiry.front().id].expiry);
+    }
+  }
+
+  auto ms=std::chrono::duration_cast<std::chrono::microseconds>(next-now).count();
+  return static_cast<int>(std::max<long long>(0, (ms+999)/1000));
+}
+
+Discover::SocketType &Discover::getSocket(std::size_t id)
+{
+  if (id < sockets_.size())
+  {
+    return sockets_[id];
+  }
+
+  return *unicast_socket_;
 }
 
 }
@@ -37,6 +37,13 @@
 #define RCDISCOVER_DISCOVER
 
 #include "deviceinfo.h"
+#include "reactor.h"
+#include "request_table.h"
+#include "interface_cache.h"
+
+#include <memory>
+#include <deque>
+#include <chrono>
 
 #ifdef WIN32
 #include "socket_windows.h"
@@ -59,12 +66,31 @@ class Discover
   public:
 
     /**
-      Initializes a socket ready for broadcasting requests.
+      Initializes a socket ready for broadcasting requests. All sockets are
+      registered in an event loop that is kept for the lifetime of the object.
 
       NOTE: Exceptions are thrown in case of severe network errors.
+
+      @param mode Number of sockets per interface. With one socket per
+                  interface, less descriptors are needed and less duplicate
+                  responses are received. The interface name of responses is
+                  the same in both modes.
+      @param filter Selection of the interfaces on which is discovered.
+                  Sockets are only created for selected interfaces.
+    */
+
+    explicit Discover(SocketMode mode=SocketMode::ThreePerInterface,
+                      const InterfaceFilter &filter=InterfaceFilter());
+
+    /**
+      Uses the sockets of the given interface cache, which can be shared with
+      other objects. The sockets are only recreated if interfaces have
+      changed.
+
+      @param cache Interface cache with destination port 3956.
     */
 
-    Discover();
+    explicit Discover(std::shared_ptr<InterfaceCache> cache);
     ~Discover();
 
     /**
@@ -74,22 +100,211 @@ class Discover
     void broadcastRequest();
 
     /**
-      Returns a discovery response. This method should be called until there is
-      no further response.
+      Sets the number of retransmissions of requests for lossy links.
+      Broadcast requests are repeated the given number of times, the first
+      time after the given interval and then with twice the interval of the
+      previous retransmission. Unanswered unicast requests of sweeps are
+      repeated with twice the timeout of the previous request. Every
+      retransmission uses new request ids and the round in which a device
+      has answered is reported by DeviceInfo::getRound().
 
-      @param info    Info object that will be filled if there is an available
-                     response.
+      Retransmissions are sent while waiting in getResponse() or
+      getAllResponses(). hasPendingRequests() returns true until the last
+      retransmission has been sent.
+
+      @param count    Number of retransmissions, 0 for none.
+      @param interval Time in Milliseconds until the first retransmission
+                      of a broadcast request.
+    */
+
+    void setRetransmits(int count, int interval=50);
+
+    /**
+      Sends unicast discovery command requests to a list of addresses, e.g.
+      for finding devices behind routers, which do not receive broadcasts.
+      The requests are sent while waiting in getResponse() or
+      getAllResponses(), with at most the given number of unanswered requests
+      in flight and with the given rate limit. The responses are returned by
+      getResponse() and getAllResponses() together with the responses to
+      broadcast requests. The interface name of these responses is the name
+      of the interface on which the response has been received.
+
+      @param ip      List of IP addresses in host byte order.
+      @param window  Maximum number of unanswered requests in flight.
+      @param rate    Maximum number of requests per second.
+      @param timeout Time in milliseconds after which an unanswered request
+                     does not count as in flight anymore.
+    */
+
+    void sweepRequest(const std::vector<uint32_t> &ip, int window=256,
+                      int rate=5000, int timeout=100);
+
+    /**
+      Checks if retransmissions or requests of a sweep are waiting to be sent
+      or are in flight. The responses should be collected until this method returns false.
+
+      @return True if there are pending requests.
+    */
+
+    bool hasPendingRequests() const;
+
+    /**
+      Returns discovery responses. This method should be called until there
+      is no further response. At most one response per socket is appended per
+      call.
+
+      @param info    List to which all valid responses are appended.
       @param timeout Timeout in Milliseconds.
-      @return        True if there was a valid response. In this case, the info
-                     object contains valid information. False in case of a
-                     timeout.
+      @return        True if there was a valid response. In this case, at least
+                     one valid info object has been appended to the list. False
+                     in case of a timeout.
     */
 
     bool getResponse(std::vector<DeviceInfo> &info, int timeout_per_socket=1000);
 
+    /**
+      Returns all pending discovery responses. In contrast to getResponse(),
+      all queued packets of all sockets are read and all valid responses are
+      appended in one call. This method should be called until there is no
+      further response.
+
+      @param info    List to which all valid responses are appended.
+      @param timeout Timeout in Milliseconds for waiting for the first
+                     response.
+      @return        True if there was at least one valid response. False in
+                     case of a timeout.
+    */
+
+    bool getAllResponses(std::vector<DeviceInfo> &info, int timeout=1000);
+
+    /**
+      Returns the names of the interfaces on which the last request has been
+      sent.
+
+      @return Sorted list of interface names.
+    */
+
+    std::vector<std::string> getInterfaceNames() const;
+
   private:
-    std::vector<SocketType> sockets_;
-    std::vector<std::tuple<std::uint8_t, std::uint8_t>> req_nums_;
+
+    /**
+      Reads packets from the given socket until a valid discovery acknowledge
+      is received or no more data is available.
+
+      @param socket      Socket with pending data.
+      @param device_info Info object that will be filled with the response.
+      @return            True if a valid response has been received.
+    */
+
+    bool receiveResponse(SocketType &socket, DeviceInfo &device_info);
+
+    /**
+      Reads all queued packets from the given socket and appends all valid
+      discovery acknowledges.
+
+      @param socket Socket with pending data.
+      @param info   List to which all valid responses are appended.
+      @return       True if at least one valid response has been appended.
+    */
+
+    bool drainResponses(SocketType &socket, std::vector<DeviceInfo> &info);
+
+    /**
+      Registers all sockets in the event loop again if the sockets of the
+      interface cache have been recreated.
+    */
+
+    void registerSockets();
+
+    /**
+      Sends a discovery command request on all sockets as next broadcast
+      round.
+
+      @param now Current time.
+    */
+
+    void sendBroadcast(std::chrono::steady_clock::time_point now);
+
+    /**
+      Waits for data on any socket and sends pending retransmissions and
+      sweep requests in the meantime.
+
+      @param timeout Timeout in Milliseconds.
+    */
+
+    void waitForData(int timeout);
+
+    /**
+      Sends all retransmissions that are due and all sweep requests that are
+      due according to the window and the rate limit.
+
+      @param timeout Maximum time in Milliseconds until the next call.
+      @return        Time in Milliseconds until the next call is needed.
+    */
+
+    int pumpRequests(int timeout);
+
+    /**
+      Returns the socket of the given reactor id.
+    */
+
+    SocketType &getSocket(std::size_t id);
+
+    /**
+      Checks if the given package is a discovery acknowledge to one of the
+      requests of this object.
+
+      @param p     Package.
+      @param n     Length of package.
+      @param round Returns the round of the request.
+      @param rtt   Returns the time since sending the request in
+                   microseconds.
+      @return      Length of the message body or 0 if the package is not
+                   valid.
+    */
+
+    size_t checkAcknowledge(const uint8_t *p, long n, int &round, int &rtt) const;
+
+    struct SweepRequest
+    {
+      uint32_t ip;
+      int round;
+      std::chrono::steady_clock::time_point expiry;
+      uint32_t serial; // 0 if not in flight
+    };
+
+    struct SweepExpiry
+    {
+      uint16_t id;
+      uint32_t serial;
+    };
+
+    struct ReceiveBuffer;
+
+    std::shared_ptr<InterfaceCache> cache_;
+    std::vector<SocketType> &sockets_;
+    unsigned int generation_;
+    Reactor reactor_;
+    std::vector<std::size_t> ready_;
+    std::unique_ptr<ReceiveBuffer> buffer_;
+    RequestTable requests_;
+
+    int retransmits_;
+    std::chrono::milliseconds retransmit_interval_;
+    int broadcast_round_;
+    std::chrono::steady_clock::time_point broadcast_next_;
+
+    std::unique_ptr<SocketType> unicast_socket_;
+    std::deque<SweepRequest> sweep_queue_;
+    std::vector<SweepRequest> sweep_slots_; // indexed by request id
+    std::vector<std::deque<SweepExpiry> > sweep_expiry_; // per round
+    std::size_t sweep_in_flight_;
+    uint32_t sweep_serial_;
+    std::size_t sweep_window_;
+    std::chrono::microseconds sweep_interval_;
+    std::chrono::milliseconds sweep_timeout_;
+    std::chrono::steady_clock::time_point sweep_next_send_;
 };
 
 }
@@ -12,26 +12,46 @@
 
 #include "socket_exception.h"
 #include "gige_request_counter.h"
+#include "reactor.h"
+
+#ifdef WIN32
+#include <winsock2.h>
+#else
+#include <sys/socket.h>
+#include <netinet/in.h>
+#endif
+
+#include <chrono>
+#include <unordered_map>
+#include <algorithm>
 
 namespace rcdiscover
 {
 
 ForceIP::ForceIP() :
-  sockets_(SocketType::createAndBindForAllInterfaces(3956))
-{
-  for (auto &socket : sockets_)
-  {
-    socket.enableBroadcast();
-    socket.enableNonBlocking();
-  }
-}
+  cache_(std::make_shared<InterfaceCache>(3956))
+{ }
 
-void ForceIP::sendCommand(const uint64_t mac, const uint32_t ip,
-                          const uint32_t subnet, const uint32_t gateway)
+ForceIP::ForceIP(const InterfaceFilter &filter) :
+  cache_(std::make_shared<InterfaceCache>(3956, SocketMode::ThreePerInterface,
+                                          filter))
+{ }
+
+ForceIP::ForceIP(std::shared_ptr<InterfaceCache> cache) :
+  cache_(std::move(cache))
+{ }
+
+std::vector<std::uint8_t> ForceIP::createCommand(const Command &command,
+                                                 const bool ack)
 {
+  const uint64_t mac = command.mac;
+  const uint32_t ip = command.ip;
+  const uint32_t subnet = command.subnet;
+  const uint32_t gateway = command.gateway;
+
   std::vector<std::uint8_t> force_ip_command(64);
   force_ip_command[0] = 0x42;
-  force_ip_command[1] = 0x00;   // flags
+  force_ip_command[1] = ack ? 0x01 : 0x00; // flags: acknowledge
   force_ip_command[2] = 0x00;   // command: FORCEIP_CMD: 0x0004
   force_ip_command[3] = 0x04;   // command: FORCEIP_CMD: 0x0004
   force_ip_command[4] = 0x00;   // length
@@ -59,7 +79,18 @@ void ForceIP::sendCommand(const uint64_t mac, const uint32_t ip,
   force_ip_command[62] = static_cast<std::uint8_t>(gateway >> 8);  // gateway
   force_ip_command[63] = static_cast<std::uint8_t>(gateway >> 0);  // gateway
 
-  for (auto &socket : sockets_)
+  return force_ip_command;
+}
+
+void ForceIP::sendCommand(const uint64_t mac, const uint32_t ip,
+                          const uint32_t subnet, const uint32_t gateway)
+{
+  std::vector<std::uint8_t> force_ip_command =
+    createCommand(Command{mac, ip, subnet, gateway}, false);
+
+  cache_->update();
+
+  for (auto &socket : cache_->getSockets())
   {
     std::tie(force_ip_command[6], force_ip_command[7]) =
         GigERequestCounter::getNext();
@@ -75,4 +106,122 @@ void ForceIP::sendCommand(const uint64_t mac, const uint32_t ip,
   }
 }
 
+std::vector<ForceIP::Result> ForceIP::sendCommands(
+  const std::vector<Command> &commands, int retries, int timeout)
+{
+  typedef std::chrono::steady_clock clock;
+
+  std::vector<Result> result(commands.size(), Result{false, 0, 0});
+
+  std::vector<std::vector<std::uint8_t>> packets;
+  packets.reserve(commands.size());
+  for (const auto &command : commands)
+  {
+    packets.push_back(createCommand(command, true));
+  }
+
+  cache_->update();
+
+  auto &sockets = cache_->getSockets();
+
+  Reactor reactor;
+  for (size_t i = 0; i < sockets.size(); i++)
+  {
+    reactor.add(sockets[i].getHandle<typename SocketType::SocketType>(), i);
+  }
+
+  // request id of every sent command, mapped to the index of the command
+
+  std::unordered_map<std::uint16_t, size_t> requests;
+  std::vector<size_t> ready;
+
+  const auto start = clock::now();
+  size_t open = commands.size();
+
+  for (int attempt = 0; attempt <= std::max(0, retries) && open > 0; attempt++)
+  {
+    // send all unacknowledged commands in one wave
+
+    for (size_t k = 0; k < packets.size(); k++)
+    {
+      if (result[k].acknowledged)
+      {
+        continue;
+      }
+
+      result[k].attempts++;
+
+      for (auto &socket : sockets)
+      {
+        std::tie(packets[k][6], packets[k][7]) = GigERequestCounter::getNext();
+        requests[static_cast<std::uint16_t>((packets[k][6] << 8) | packets[k][7])] = k;
+
+        try
+        {
+          socket.send(packets[k]);
+        }
+        catch(const NetworkUnreachableException &)
+        {
+          continue;
+        }
+      }
+    }
+
+    // collect acknowledges of this and all previous waves
+
+    const auto wave_end = clock::now() +
+      std::chrono::milliseconds(std::max(1, timeout) << std::min(attempt, 16));
+
+    auto now = clock::now();
+    while (open > 0 && now < wave_end)
+    {
+      reactor.wait(ready, static_cast<int>(std::chrono::duration_cast<
+        std::chrono::milliseconds>(wave_end-now).count())+1);
+
+      for (size_t i : ready)
+      {
+        const auto sock = sockets[i].getHandle<typename SocketType::SocketType>();
+
+        while (true)
+        {
+          // FORCEIP_ACK consists of the header only
+
+          std::uint8_t p[64];
+          const long n = recvfrom(sock, reinterpret_cast<char *>(p), sizeof(p),
+                                  0, nullptr, nullptr);
+
+          if (n < 0)
+          {
+            // no more data available on this non-blocking socket
+
+            break;
+          }
+
+          if (n < 8 || p[0] != 0x00 || p[1] != 0x00 || // status: success
+              p[2] != 0x00 || p[3] != 0x05)            // FORCEIP_ACK: 0x0005
+          {
+            continue;
+          }
+
+          const auto request = requests.find(
+            static_cast<std::uint16_t>((p[6] << 8) | p[7]));
+
+          if (request != requests.end() && !result[request->second].acknowledged)
+          {
+            result[request->second].acknowledged = true;
+            result[request->second].time = static_cast<int>(
+              std::chrono::duration_cast<std::chrono::milliseconds>(
+                clock::now()-start).count());
+            open--;
+          }
+        }
+      }
+
+      now = clock::now();
+    }
+  }
+
+  return result;
+}
+
 }
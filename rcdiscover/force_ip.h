@@ -11,11 +11,11 @@
 #ifndef FORCE_IP_H
 #define FORCE_IP_H
 
-#ifdef WIN32
-#include "socket_windows.h"
-#else
-#include "socket_linux.h"
-#endif
+#include "interface_cache.h"
+
+#include <memory>
+#include <vector>
+#include <cstdint>
 
 namespace rcdiscover
 {
@@ -32,6 +32,27 @@ class ForceIP
     typedef SocketLinux SocketType;
 #endif
 
+    /**
+     * @brief Parameters of a FORCEIP_CMD for one device.
+     */
+    struct Command
+    {
+      std::uint64_t mac;     ///< destination MAC address
+      std::uint32_t ip;      ///< desired IP address, 0 for reconnect
+      std::uint32_t subnet;  ///< desired subnet mask
+      std::uint32_t gateway; ///< desired default gateway
+    };
+
+    /**
+     * @brief Outcome of an acknowledged FORCEIP_CMD for one device.
+     */
+    struct Result
+    {
+      bool acknowledged; ///< true if FORCEIP_ACK has been received
+      int attempts;      ///< number of times the command has been sent
+      int time;          ///< milliseconds until the acknowledge
+    };
+
   public:
     /**
      * @brief Constructor.
@@ -39,6 +60,20 @@ class ForceIP
      */
     ForceIP();
 
+    /**
+     * @brief Constructor.
+     * Sets up sockets for the selected interfaces.
+     * @param filter selection of interfaces
+     */
+    explicit ForceIP(const InterfaceFilter &filter);
+
+    /**
+     * @brief Constructor.
+     * Uses the sockets of the given interface cache.
+     * @param cache interface cache with destination port 3956
+     */
+    explicit ForceIP(std::shared_ptr<InterfaceCache> cache);
+
     /**
      * @brief Send FORCEIP_CMD.
      * @param mac the destination MAC address
@@ -51,8 +86,32 @@ class ForceIP
     void sendCommand(std::uint64_t mac, std::uint32_t ip,
                      std::uint32_t subnet, std::uint32_t gateway);
 
+    /**
+     * @brief Sends FORCEIP_CMD with acknowledge request to many devices at
+     * once and waits for FORCEIP_ACK, which is matched by the request id.
+     * All commands are sent in one wave and unacknowledged commands are
+     * sent again with new request ids and twice the timeout of the previous
+     * wave.
+     * @param commands commands for all devices
+     * @param retries number of times unacknowledged commands are repeated
+     * @param timeout time in milliseconds to wait for acknowledges of the
+     * first wave
+     * @return result per command in the same order as the commands
+     */
+    std::vector<Result> sendCommands(const std::vector<Command> &commands,
+                                     int retries=3, int timeout=100);
+
   private:
-    std::vector<SocketType> sockets_;
+    /**
+     * @brief Creates FORCEIP_CMD.
+     * @param command parameters of the command
+     * @param ack true for requesting FORCEIP_ACK
+     * @return FORCEIP_CMD without request id
+     */
+    static std::vector<std::uint8_t> createCommand(const Command &command,
+                                                   bool ack);
+
+    std::shared_ptr<InterfaceCache> cache_;
 };
 
 }
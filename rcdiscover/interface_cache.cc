@@ -0,0 +1,258 @@
+/*
+ * rcdiscover - the network discovery tool for Roboception devices
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "interface_cache.h"
+
+#ifdef WIN32
+#include <iphlpapi.h>
+#else
+#include <sys/socket.h>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+#include <unistd.h>
+#include <errno.h>
+#endif
+
+#include <algorithm>
+#include <cstring>
+
+namespace rcdiscover
+{
+
+#ifdef WIN32
+
+InterfaceCache::InterfaceCache(uint16_t port, SocketMode mode,
+                               const InterfaceFilter &filter) :
+  port_(port),
+  mode_(mode),
+  filter_(filter),
+  generation_(0),
+  fixed_(false),
+  notify_handle_(NULL)
+{
+  // subscribe before enumerating, so that no change can be missed
+
+  memset(&notify_, 0, sizeof(notify_));
+  notify_.hEvent=WSACreateEvent();
+
+  if (notify_.hEvent != WSA_INVALID_EVENT &&
+      NotifyAddrChange(&notify_handle_, &notify_) != ERROR_IO_PENDING)
+  {
+    WSACloseEvent(notify_.hEvent);
+    notify_.hEvent=WSA_INVALID_EVENT;
+  }
+
+  rebuild();
+}
+
+InterfaceCache::InterfaceCache(std::vector<SocketType> sockets) :
+  port_(0),
+  mode_(SocketMode::ThreePerInterface),
+  sockets_(std::move(sockets)),
+  generation_(1),
+  fixed_(true),
+  notify_handle_(NULL)
+{
+  memset(&notify_, 0, sizeof(notify_));
+  notify_.hEvent=WSA_INVALID_EVENT;
+}
+
+InterfaceCache::~InterfaceCache()
+{
+  if (notify_.hEvent != WSA_INVALID_EVENT)
+  {
+    CancelIPChangeNotify(&notify_);
+    WSACloseEvent(notify_.hEvent);
+  }
+}
+
+bool InterfaceCache::hasChanged()
+{
+  if (notify_.hEvent == WSA_INVALID_EVENT)
+  {
+    return true;
+  }
+
+  if (WaitForSingleObject(notify_.hEvent, 0) != WAIT_OBJECT_0)
+  {
+    return false;
+  }
+
+  // notifications must be requested again after each change
+
+  WSAResetEvent(notify_.hEvent);
+
+  if (NotifyAddrChange(&notify_handle_, &notify_) != ERROR_IO_PENDING)
+  {
+    WSACloseEvent(notify_.hEvent);
+    notify_.hEvent=WSA_INVALID_EVENT;
+  }
+
+  return true;
+}
+
+#else
+
+InterfaceCache::InterfaceCache(uint16_t port, SocketMode mode,
+                               const InterfaceFilter &filter) :
+  port_(port),
+  mode_(mode),
+  filter_(filter),
+  generation_(0),
+  fixed_(false),
+  notify_(-1)
+{
+  // subscribe before enumerating, so that no change can be missed
+
+  notify_=::socket(AF_NETLINK, SOCK_RAW | SOCK_NONBLOCK | SOCK_CLOEXEC,
+                   NETLINK_ROUTE);
+
+  if (notify_ != -1)
+  {
+    sockaddr_nl addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.nl_family=AF_NETLINK;
+    addr.nl_groups=RTMGRP_LINK | RTMGRP_IPV4_IFADDR;
+
+    if (::bind(notify_, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) == -1)
+    {
+      ::close(notify_);
+      notify_=-1;
+    }
+  }
+
+  rebuild();
+}
+
+InterfaceCache::InterfaceCache(std::vector<SocketType> sockets) :
+  port_(0),
+  mode_(SocketMode::ThreePerInterface),
+  sockets_(std::move(sockets)),
+  generation_(1),
+  fixed_(true),
+  notify_(-1)
+{ }
+
+InterfaceCache::~InterfaceCache()
+{
+  if (notify_ != -1)
+  {
+    ::close(notify_);
+  }
+}
+
+bool InterfaceCache::hasChanged()
+{
+  if (notify_ == -1)
+  {
+    return true;
+  }
+
+  bool changed=false;
+
+  while (true)
+  {
+    uint32_t buffer[2048];
+    const ssize_t n=::recv(notify_, buffer, sizeof(buffer), 0);
+
+    if (n < 0)
+    {
+      if (errno == ENOBUFS)
+      {
+        // notifications have been lost
+
+        changed=true;
+        continue;
+      }
+
+      break;
+    }
+
+    int len=static_cast<int>(n);
+    for (const nlmsghdr *msg=reinterpret_cast<const nlmsghdr *>(buffer);
+         NLMSG_OK(msg, len); msg=NLMSG_NEXT(msg, len))
+    {
+      if (msg->nlmsg_type == RTM_NEWLINK || msg->nlmsg_type == RTM_DELLINK ||
+          msg->nlmsg_type == RTM_NEWADDR || msg->nlmsg_type == RTM_DELADDR)
+      {
+        changed=true;
+      }
+    }
+  }
+
+  return changed;
+}
+
+#endif
+
+bool InterfaceCache::update()
+{
+  if (fixed_ || !hasChanged())
+  {
+    return false;
+  }
+
+  rebuild();
+  return true;
+}
+
+void InterfaceCache::rebuild()
+{
+  std::vector<SocketType> sockets=
+    SocketType::createAndBindForAllInterfaces(port_, mode_, filter_);
+
+  for (auto &socket : sockets)
+  {
+    socket.enableBroadcast();
+    socket.enableNonBlocking();
+  }
+
+  sockets_.swap(sockets);
+  generation_++;
+}
+
+std::vector<std::string> InterfaceCache::getInterfaceNames() const
+{
+  std::vector<std::string> names;
+  for (const SocketType &socket : sockets_)
+  {
+    names.push_back(socket.getIfaceName());
+  }
+
+  std::sort(names.begin(), names.end());
+  names.erase(std::unique(names.begin(), names.end()), names.end());
+
+  return names;
+}
+
+}
@@ -0,0 +1,152 @@
+/*
+ * rcdiscover - the network discovery tool for Roboception devices
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef RCDISCOVER_INTERFACE_CACHE_H
+#define RCDISCOVER_INTERFACE_CACHE_H
+
+#ifdef WIN32
+#include "socket_windows.h"
+#else
+#include "socket_linux.h"
+#endif
+
+#include <vector>
+#include <string>
+#include <cstdint>
+
+namespace rcdiscover
+{
+
+/**
+ * @brief Keeps the sockets of all interfaces and recreates them only if
+ * interfaces or addresses change.
+ *
+ * Changes are detected with RTNETLINK link and IPv4 address notifications
+ * on Linux and with NotifyAddrChange() on Windows. If notifications are not
+ * available, the sockets are recreated on every update().
+ *
+ * The sockets are shared by all users of the cache, e.g. Discover, ForceIP
+ * and WOL. The cache must not be used by several threads at the same time.
+ */
+class InterfaceCache
+{
+  public:
+#ifdef WIN32
+    typedef SocketWindows SocketType;
+#else
+    typedef SocketLinux SocketType;
+#endif
+
+  public:
+    /**
+     * @brief Constructor. Subscribes to change notifications and creates
+     * the sockets for all interfaces.
+     * @param port destination port of the sockets
+     * @param mode number of sockets per interface
+     * @param filter selection of interfaces
+     */
+    explicit InterfaceCache(uint16_t port=3956,
+                            SocketMode mode=SocketMode::ThreePerInterface,
+                            const InterfaceFilter &filter=InterfaceFilter());
+
+    /**
+     * @brief Constructor. Uses the given sockets, which are never recreated,
+     * e.g. for sockets that are bound to other addresses than the
+     * interfaces. The sockets must be non-blocking.
+     * @param sockets sockets to be used
+     */
+    explicit InterfaceCache(std::vector<SocketType> sockets);
+
+    ~InterfaceCache();
+
+    InterfaceCache(const InterfaceCache &) = delete;
+    InterfaceCache &operator=(const InterfaceCache &) = delete;
+
+    /**
+     * @brief Recreates the sockets if interfaces have changed since the last
+     * call.
+     * @return true if the sockets have been recreated
+     */
+    bool update();
+
+    /**
+     * @brief Returns the sockets, which are enabled for broadcast and
+     * non-blocking. The returned vector stays the same object, but its
+     * content is replaced if the sockets are recreated.
+     * @return sockets of all interfaces
+     */
+    std::vector<SocketType> &getSockets() { return sockets_; }
+
+    /**
+     * @brief Returns a number that changes every time the sockets are
+     * recreated.
+     * @return generation of the sockets
+     */
+    unsigned int getGeneration() const { return generation_; }
+
+    /**
+     * @brief Returns the names of all interfaces for which sockets exist.
+     * @return sorted list of interface names without duplicates
+     */
+    std::vector<std::string> getInterfaceNames() const;
+
+  private:
+    /**
+     * @brief Reads all pending notifications.
+     * @return true if interfaces may have changed
+     */
+    bool hasChanged();
+
+    /**
+     * @brief Creates the sockets for all interfaces.
+     */
+    void rebuild();
+
+    uint16_t port_;
+    SocketMode mode_;
+    InterfaceFilter filter_;
+    std::vector<SocketType> sockets_;
+    unsigned int generation_;
+    bool fixed_;
+
+#ifdef WIN32
+    OVERLAPPED notify_;
+    HANDLE notify_handle_;
+#else
+    int notify_;
+#endif
+};
+
+}
+
+#endif // RCDISCOVER_INTERFACE_CACHE_H
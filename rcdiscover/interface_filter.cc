@@ -0,0 +1,186 @@
+/*
+ * rcdiscover - the network discovery tool for Roboception devices
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "interface_filter.h"
+
+#include "utils.h"
+
+#ifdef WIN32
+#include <winsock2.h>
+#include <iphlpapi.h>
+#else
+#include <sys/socket.h>
+#include <sys/ioctl.h>
+#include <net/if.h>
+#include <linux/ethtool.h>
+#include <linux/sockios.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cstring>
+#include <cstdlib>
+
+namespace rcdiscover
+{
+
+InterfaceFilter::InterfaceFilter() : skip_types_(0)
+{ }
+
+void InterfaceFilter::include(std::string pattern)
+{
+  include_.push_back(std::move(pattern));
+}
+
+void InterfaceFilter::exclude(std::string pattern)
+{
+  exclude_.push_back(std::move(pattern));
+}
+
+void InterfaceFilter::skipTypes(unsigned int types)
+{
+  skip_types_|=types;
+}
+
+bool InterfaceFilter::accepts(const std::string &name) const
+{
+  const auto matches=[&name](const std::string &pattern)
+  {
+    return wildcardMatch(name.begin(), name.end(), pattern.begin(), pattern.end());
+  };
+
+  if (!include_.empty() && std::none_of(include_.begin(), include_.end(), matches))
+  {
+    return false;
+  }
+
+  if (std::any_of(exclude_.begin(), exclude_.end(), matches))
+  {
+    return false;
+  }
+
+  // the type is only determined if needed, since it requires system calls
+
+  if (skip_types_ != 0 && (getType(name) & skip_types_) != 0)
+  {
+    return false;
+  }
+
+  return true;
+}
+
+#ifdef WIN32
+
+unsigned int InterfaceFilter::getType(const std::string &name)
+{
+  ULONG buflen=15000;
+  PIP_ADAPTER_ADDRESSES addresses=nullptr;
+
+  ULONG result=ERROR_BUFFER_OVERFLOW;
+  for (int i=0; i<3 && result == ERROR_BUFFER_OVERFLOW; i++)
+  {
+    free(addresses);
+    addresses=static_cast<PIP_ADAPTER_ADDRESSES>(malloc(buflen));
+    result=GetAdaptersAddresses(AF_INET, GAA_FLAG_SKIP_ANYCAST |
+                                GAA_FLAG_SKIP_MULTICAST | GAA_FLAG_SKIP_DNS_SERVER,
+                                nullptr, addresses, &buflen);
+  }
+
+  unsigned int ret=0;
+
+  if (result == NO_ERROR)
+  {
+    for (PIP_ADAPTER_ADDRESSES a=addresses; a != nullptr; a=a->Next)
+    {
+      if (name == a->AdapterName && a->IfType == IF_TYPE_TUNNEL)
+      {
+        ret=Tun;
+      }
+    }
+  }
+
+  free(addresses);
+
+  return ret;
+}
+
+#else
+
+unsigned int InterfaceFilter::getType(const std::string &name)
+{
+  // the name of the driver identifies virtual interfaces
+
+  int fd=::socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+  if (fd == -1)
+  {
+    return 0;
+  }
+
+  ethtool_drvinfo info;
+  memset(&info, 0, sizeof(info));
+  info.cmd=ETHTOOL_GDRVINFO;
+
+  ifreq ifr;
+  memset(&ifr, 0, sizeof(ifr));
+  strncpy(ifr.ifr_name, name.c_str(), IFNAMSIZ-1);
+  ifr.ifr_data=reinterpret_cast<char *>(&info);
+
+  const int ret=::ioctl(fd, SIOCETHTOOL, &ifr);
+  ::close(fd);
+
+  if (ret == -1)
+  {
+    return 0;
+  }
+
+  const std::string driver(info.driver, strnlen(info.driver, sizeof(info.driver)));
+
+  if (driver == "bridge")
+  {
+    return Bridge;
+  }
+  else if (driver == "veth")
+  {
+    return Veth;
+  }
+  else if (driver == "tun" || driver == "wireguard")
+  {
+    return Tun;
+  }
+
+  return 0;
+}
+
+#endif
+
+}
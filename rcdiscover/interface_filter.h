@@ -0,0 +1,107 @@
+/*
+ * rcdiscover - the network discovery tool for Roboception devices
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef RCDISCOVER_INTERFACE_FILTER_H
+#define RCDISCOVER_INTERFACE_FILTER_H
+
+#include <string>
+#include <vector>
+
+namespace rcdiscover
+{
+
+/**
+ * @brief Selects the interfaces for which sockets are created.
+ *
+ * Interfaces are selected by include and exclude patterns with the wildcards
+ * '*' and '?' and can be skipped by type. Without any settings, all
+ * interfaces are selected.
+ */
+class InterfaceFilter
+{
+  public:
+    /**
+     * @brief Interface types that can be skipped.
+     */
+    enum Type
+    {
+      Bridge=1, ///< Bridge, e.g. docker0
+      Veth=2,   ///< Virtual ethernet pair, e.g. of containers
+      Tun=4     ///< TUN / TAP devices and other tunnels of VPNs
+    };
+
+    InterfaceFilter();
+
+    /**
+     * @brief Adds a pattern of interfaces that are selected. If no include
+     * pattern is given, all interfaces are selected.
+     * @param pattern interface name with optional wildcards
+     */
+    void include(std::string pattern);
+
+    /**
+     * @brief Adds a pattern of interfaces that are not selected, even if
+     * they match an include pattern.
+     * @param pattern interface name with optional wildcards
+     */
+    void exclude(std::string pattern);
+
+    /**
+     * @brief Skips interfaces of the given types.
+     * @param types combination of Type values
+     */
+    void skipTypes(unsigned int types);
+
+    /**
+     * @brief Checks if the interface with the given name is selected.
+     * @param name interface name
+     * @return true if selected
+     */
+    bool accepts(const std::string &name) const;
+
+    /**
+     * @brief Determines the type of an interface.
+     * @param name interface name
+     * @return one of the Type values or 0 if the type is none of them
+     */
+    static unsigned int getType(const std::string &name);
+
+  private:
+    std::vector<std::string> include_;
+    std::vector<std::string> exclude_;
+    unsigned int skip_types_;
+};
+
+}
+
+#endif // RCDISCOVER_INTERFACE_FILTER_H
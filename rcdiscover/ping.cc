@@ -40,22 +40,39 @@
 
 #ifdef WIN32
 #include <winsock2.h>
+#include <ws2tcpip.h>
 #include <iphlpapi.h>
 #include <icmpapi.h>
+#include <future>
 #else
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/ip.h>
+#include <fcntl.h>
+#include <arpa/inet.h>
+#include <poll.h>
 #include <unistd.h>
+#include <errno.h>
 #endif
 
+#include <chrono>
+#include <algorithm>
+#include <string>
+#include <cstring>
+
 namespace rcdiscover
 {
 
 #ifdef WIN32
 
-bool checkReachabilityOfSensor(const DeviceInfo &info)
+namespace
+{
+
+bool pingAddress(uint32_t ip, int timeout)
 {
   char data[] = "data";
 
-  ULONG ipaddr = htonl(info.getIP());
+  ULONG ipaddr = htonl(ip);
 
   HANDLE h_icmp = IcmpCreateFile();
   if (h_icmp == INVALID_HANDLE_VALUE)
@@ -73,26 +90,53 @@ bool checkReachabilityOfSensor(const DeviceInfo &info)
 
   DWORD result = IcmpSendEcho(h_icmp, ipaddr, data,
                               sizeof(data), nullptr,
-                              reply_buffer, reply_size, 1000);
+                              reply_buffer, reply_size, timeout);
 
   IcmpCloseHandle(h_icmp);
 
-  if (result != 0 &&
-      reinterpret_cast<ICMP_ECHO_REPLY *>(reply_buffer)->Status == IP_SUCCESS)
+  const bool ret = result != 0 &&
+    reinterpret_cast<ICMP_ECHO_REPLY *>(reply_buffer)->Status == IP_SUCCESS;
+
+  free(reply_buffer);
+
+  return ret;
+}
+
+}
+
+std::vector<bool> checkReachability(const std::vector<uint32_t> &ip,
+                                    int timeout)
+{
+  // IcmpSendEcho() blocks until the reply or timeout, so that all addresses
+  // are pinged in parallel
+
+  std::vector<std::future<bool> > pending;
+  for (const uint32_t a : ip)
   {
-    return true;
+    pending.push_back(std::async(std::launch::async, pingAddress, a, timeout));
   }
-  else
+
+  std::vector<bool> result;
+  for (auto &p : pending)
   {
-    return false;
+    result.push_back(p.get());
   }
+
+  return result;
 }
 
 #else
 
-bool checkReachabilityOfSensor(const DeviceInfo &info)
+namespace
 {
-  const std::string command = "ping -c 1 -W 1 " + ip2string(info.getIP());
+
+bool pingCommand(uint32_t ip, int timeout)
+{
+  // the timeout of ping is given in full seconds
+
+  const int seconds = std::max(1, (timeout+999)/1000);
+  const std::string command = "ping -c 1 -W " + std::to_string(seconds) + " " +
+    ip2string(ip);
 
   FILE *in;
   if (!(in = popen(command.c_str(), "r")))
@@ -109,6 +153,390 @@ bool checkReachabilityOfSensor(const DeviceInfo &info)
   return exit_code == 0;
 }
 
+uint16_t icmpChecksum(const uint8_t *p, size_t n)
+{
+  uint32_t sum = 0;
+  for (size_t i = 0; i+1 < n; i += 2)
+  {
+    sum += static_cast<uint32_t>((p[i] << 8) | p[i+1]);
+  }
+
+  if (n & 1)
+  {
+    sum += static_cast<uint32_t>(p[n-1] << 8);
+  }
+
+  while (sum >> 16)
+  {
+    sum = (sum & 0xffff) + (sum >> 16);
+  }
+
+  return static_cast<uint16_t>(~sum);
+}
+
+}
+
+std::vector<bool> checkReachability(const std::vector<uint32_t> &ip,
+                                    int timeout)
+{
+  typedef std::chrono::steady_clock clock;
+
+  std::vector<bool> result(ip.size(), false);
+
+  if (ip.empty())
+  {
+    return result;
+  }
+
+  // unprivileged echo sockets replace the identifier by their own and only
+  // receive their own replies, raw sockets receive all ICMP packets
+  // including the IP header
+
+  bool raw = false;
+  int fd = ::socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, IPPROTO_ICMP);
+  if (fd < 0)
+  {
+    raw = true;
+    fd = ::socket(AF_INET, SOCK_RAW | SOCK_CLOEXEC, IPPROTO_ICMP);
+  }
+
+  if (fd < 0)
+  {
+    for (size_t i = 0; i < ip.size(); i++)
+    {
+      result[i] = pingCommand(ip[i], timeout);
+    }
+
+    return result;
+  }
+
+  const uint16_t id = static_cast<uint16_t>(::getpid());
+
+  // one echo request per address, which is identified by its sequence
+  // number
+
+  for (size_t i = 0; i < ip.size() && i < 65536; i++)
+  {
+    uint8_t p[16];
+    memset(p, 0, sizeof(p));
+    p[0] = 8; // echo request
+    p[4] = static_cast<uint8_t>(id >> 8);
+    p[5] = static_cast<uint8_t>(id);
+    p[6] = static_cast<uint8_t>(i >> 8);
+    p[7] = static_cast<uint8_t>(i);
+    memcpy(p+8, "rcdiscov", 8);
+
+    const uint16_t sum = icmpChecksum(p, sizeof(p));
+    p[2] = static_cast<uint8_t>(sum >> 8);
+    p[3] = static_cast<uint8_t>(sum);
+
+    sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(ip[i]);
+
+    // a full send buffer is waited for, other errors like unreachable
+    // networks just let the address fail
+
+    while (::sendto(fd, p, sizeof(p), MSG_DONTWAIT,
+                    reinterpret_cast<const sockaddr *>(&addr), sizeof(addr)) < 0 &&
+           (errno == EAGAIN || errno == EWOULDBLOCK))
+    {
+      pollfd pfd;
+      pfd.fd = fd;
+      pfd.events = POLLOUT;
+      pfd.revents = 0;
+
+      if (::poll(&pfd, 1, 100) <= 0)
+      {
+        break;
+      }
+    }
+  }
+
+  // collect replies of all addresses within one timeout
+
+  const auto end = clock::now()+std::chrono::milliseconds(timeout);
+  size_t open = ip.size();
+
+  auto now = clock::now();
+  while (open > 0 && now < end)
+  {
+    pollfd pfd;
+    pfd.fd = fd;
+    pfd.events = POLLIN;
+    pfd.revents = 0;
+
+    const int wait = static_cast<int>(std::chrono::duration_cast<
+      std::chrono::milliseconds>(end-now).count())+1;
+
+    if (::poll(&pfd, 1, wait) > 0)
+    {
+      while (true)
+      {
+        uint8_t p[1500];
+        sockaddr_in from;
+        socklen_t from_len = sizeof(from);
+
+        ssize_t n = ::recvfrom(fd, p, sizeof(p), MSG_DONTWAIT,
+                               reinterpret_cast<sockaddr *>(&from), &from_len);
+
+        if (n < 0)
+        {
+          break;
+        }
+
+        const uint8_t *icmp = p;
+        if (raw)
+        {
+          const size_t header = static_cast<size_t>(p[0] & 0x0f)*4;
+          if (static_cast<size_t>(n) < header)
+          {
+            continue;
+          }
+
+          icmp += header;
+          n -= static_cast<ssize_t>(header);
+        }
+
+        if (n < 8 || icmp[0] != 0 || icmp[1] != 0 || // echo reply
+            (raw && ((icmp[4] << 8) | icmp[5]) != id))
+        {
+          continue;
+        }
+
+        const size_t i = static_cast<size_t>((icmp[6] << 8) | icmp[7]);
+
+        if (i < ip.size() && !result[i] && ntohl(from.sin_addr.s_addr) == ip[i])
+        {
+          result[i] = true;
+          open--;
+        }
+      }
+    }
+
+    now = clock::now();
+  }
+
+  ::close(fd);
+
+  return result;
+}
+
+#endif
+
+namespace
+{
+
+#ifdef WIN32
+typedef SOCKET tcp_socket_t;
+const tcp_socket_t invalid_tcp_socket = INVALID_SOCKET;
+
+void closeTCPSocket(tcp_socket_t s)
+{
+  ::closesocket(s);
+}
+
+int pollSockets(std::vector<pollfd> &fds, int timeout)
+{
+  return ::WSAPoll(fds.data(), static_cast<ULONG>(fds.size()), timeout);
+}
+#else
+typedef int tcp_socket_t;
+const tcp_socket_t invalid_tcp_socket = -1;
+
+void closeTCPSocket(tcp_socket_t s)
+{
+  ::close(s);
+}
+
+int pollSockets(std::vector<pollfd> &fds, int timeout)
+{
+  return ::poll(fds.data(), static_cast<nfds_t>(fds.size()), timeout);
+}
 #endif
 
+/*
+  Creates a non-blocking socket and starts connecting. Returns the invalid
+  socket if the connect failed immediately, e.g. due to an unreachable
+  network, and sets connected if it succeeded immediately.
+*/
+
+tcp_socket_t startConnect(uint32_t ip, uint16_t port, bool &connected)
+{
+  connected = false;
+
+  tcp_socket_t s = ::socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+  if (s == invalid_tcp_socket)
+  {
+    return s;
+  }
+
+#ifdef WIN32
+  u_long nonblocking = 1;
+  const bool ok = ::ioctlsocket(s, FIONBIO, &nonblocking) == 0;
+#else
+  const bool ok = ::fcntl(s, F_SETFD, FD_CLOEXEC) == 0 &&
+    ::fcntl(s, F_SETFL, ::fcntl(s, F_GETFL)|O_NONBLOCK) == 0;
+#endif
+
+  if (!ok)
+  {
+    closeTCPSocket(s);
+    return invalid_tcp_socket;
+  }
+
+  sockaddr_in addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family = AF_INET;
+  addr.sin_port = htons(port);
+  addr.sin_addr.s_addr = htonl(ip);
+
+  if (::connect(s, reinterpret_cast<const sockaddr *>(&addr),
+                sizeof(addr)) == 0)
+  {
+    connected = true;
+    return s;
+  }
+
+#ifdef WIN32
+  const bool pending = ::WSAGetLastError() == WSAEWOULDBLOCK;
+#else
+  const bool pending = errno == EINPROGRESS;
+#endif
+
+  if (!pending)
+  {
+    closeTCPSocket(s);
+    return invalid_tcp_socket;
+  }
+
+  return s;
+}
+
+}
+
+std::vector<bool> checkTCPReachability(const std::vector<uint32_t> &ip,
+                                       uint16_t port, int timeout,
+                                       size_t window)
+{
+  typedef std::chrono::steady_clock clock;
+
+  std::vector<bool> result(ip.size(), false);
+  window = std::max<size_t>(1, window);
+
+  // fds contains only pending connects, index maps them back to the address
+  // and expiry gives the end of their timeout
+
+  std::vector<pollfd> fds;
+  std::vector<size_t> index;
+  std::vector<clock::time_point> expiry;
+
+  size_t next = 0;
+  auto now = clock::now();
+
+  while (next < ip.size() || !fds.empty())
+  {
+    // start connects until the window is full
+
+    while (next < ip.size() && fds.size() < window)
+    {
+      const size_t i = next++;
+
+      bool connected;
+      tcp_socket_t s = startConnect(ip[i], port, connected);
+
+      if (s == invalid_tcp_socket)
+      {
+        continue;
+      }
+
+      if (connected)
+      {
+        result[i] = true;
+        closeTCPSocket(s);
+        continue;
+      }
+
+      pollfd pfd;
+      pfd.fd = s;
+      pfd.events = POLLOUT;
+      pfd.revents = 0;
+
+      fds.push_back(pfd);
+      index.push_back(i);
+      expiry.push_back(now+std::chrono::milliseconds(timeout));
+    }
+
+    if (fds.empty())
+    {
+      continue;
+    }
+
+    // wait until the next connect completes or expires, which is the
+    // oldest one
+
+    const auto us = std::chrono::duration_cast<std::chrono::microseconds>(
+      expiry.front()-now).count();
+    const int wait = static_cast<int>((std::max<long long>(0, us)+999)/1000);
+
+    const bool ready = pollSockets(fds, wait) > 0;
+    now = clock::now();
+
+    // a connect is completed when the socket becomes writable, its outcome
+    // is given by SO_ERROR
+
+    size_t k = 0;
+    for (size_t j = 0; j < fds.size(); j++)
+    {
+      if (ready && fds[j].revents != 0)
+      {
+        int err = 0;
+        socklen_t len = sizeof(err);
+        if (::getsockopt(fds[j].fd, SOL_SOCKET, SO_ERROR,
+                         reinterpret_cast<char *>(&err), &len) == 0 && err == 0)
+        {
+          result[index[j]] = true;
+        }
+
+        closeTCPSocket(fds[j].fd);
+      }
+      else if (expiry[j] <= now)
+      {
+        closeTCPSocket(fds[j].fd);
+      }
+      else
+      {
+        fds[k] = fds[j];
+        fds[k].revents = 0;
+        index[k] = index[j];
+        expiry[k] = expiry[j];
+        k++;
+      }
+    }
+
+    fds.resize(k);
+    index.resize(k);
+    expiry.resize(k);
+  }
+
+  return result;
+}
+
+std::vector<bool> checkReachability(const std::vector<uint32_t> &ip,
+                                    ReachabilityMode mode, int timeout)
+{
+  if (mode == ReachabilityMode::TCP)
+  {
+    return checkTCPReachability(ip, 80, timeout);
+  }
+
+  return checkReachability(ip, timeout);
+}
+
+bool checkReachabilityOfSensor(const DeviceInfo &info)
+{
+  return checkReachability(std::vector<uint32_t>(1, info.getIP()))[0];
+}
+
 }
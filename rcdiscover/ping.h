@@ -39,9 +39,70 @@
 
 #include "deviceinfo.h"
 
+#include <vector>
+#include <cstdint>
+
 namespace rcdiscover
 {
 
+/**
+ * @brief Method used for checking the reachability of devices.
+ */
+enum class ReachabilityMode
+{
+  /// ICMP echo request
+  ICMP,
+  /// TCP connect to the port of the web GUI
+  TCP
+};
+
+/**
+ * @brief Checks whether devices are reachable via ICMP. Echo requests are
+ * sent to all addresses at once and the replies are matched by sequence
+ * number, so that the results of all addresses are available within one
+ * timeout.
+ *
+ * On Linux, unprivileged ICMP echo sockets are used if permitted by
+ * net.ipv4.ping_group_range, otherwise raw sockets, which require root
+ * privileges. If none of them is available, the ping command is used for
+ * every address.
+ * @param ip IP addresses in host byte order
+ * @param timeout time in milliseconds to wait for replies
+ * @return whether the device with the address of the same index is reachable
+ */
+std::vector<bool> checkReachability(const std::vector<uint32_t> &ip,
+                                    int timeout=1000);
+
+/**
+ * @brief Checks whether devices accept TCP connections on the given port.
+ * Non-blocking connects are completed in a single poll loop. At most window
+ * connects are pending at the same time and a new connect is started as soon
+ * as one completes, so that the number of open sockets stays bounded. The
+ * results of up to window addresses are available within one timeout.
+ *
+ * In contrast to ICMP, this proves that the web server of the device
+ * answers and also works in networks that filter ICMP. Refused connections
+ * count as not reachable.
+ * @param ip IP addresses in host byte order
+ * @param port TCP port, which is the port of the web GUI by default
+ * @param timeout time in milliseconds to wait for each connection
+ * @param window maximum number of pending connects
+ * @return whether the device with the address of the same index is reachable
+ */
+std::vector<bool> checkTCPReachability(const std::vector<uint32_t> &ip,
+                                       uint16_t port=80, int timeout=1000,
+                                       size_t window=256);
+
+/**
+ * @brief Checks whether devices are reachable with the given method.
+ * @param ip IP addresses in host byte order
+ * @param mode ICMP echo or TCP connect to port 80
+ * @param timeout time in milliseconds to wait for replies
+ * @return whether the device with the address of the same index is reachable
+ */
+std::vector<bool> checkReachability(const std::vector<uint32_t> &ip,
+                                    ReachabilityMode mode, int timeout=1000);
+
 /**
  * @brief Check whether an device is reachable via ICMP.
  * @param info DeviceInfo of device
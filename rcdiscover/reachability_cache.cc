@@ -0,0 +1,170 @@
+/*
+ * rcdiscover - the network discovery tool for Roboception devices
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "reachability_cache.h"
+
+namespace rcdiscover
+{
+
+ReachabilityCache::ReachabilityCache(int _ttl, int _negative_ttl) :
+  ttl(_ttl), negative_ttl(_negative_ttl), generation(0), hits(0), misses(0)
+{ }
+
+void ReachabilityCache::setTTL(int _ttl)
+{
+  std::lock_guard<std::mutex> lock(mtx);
+  ttl=std::chrono::milliseconds(_ttl);
+}
+
+void ReachabilityCache::setNegativeTTL(int _ttl)
+{
+  std::lock_guard<std::mutex> lock(mtx);
+  negative_ttl=std::chrono::milliseconds(_ttl);
+}
+
+std::vector<bool> ReachabilityCache::check(const std::vector<DeviceInfo> &devices,
+                                           ReachabilityMode mode, int timeout)
+{
+  std::vector<bool> result(devices.size(), false);
+  std::vector<uint32_t> ip;
+  std::vector<size_t> probed;
+  uint64_t start_generation;
+
+  {
+    std::lock_guard<std::mutex> lock(mtx);
+
+    start_generation=generation;
+
+    const clock::time_point now=clock::now();
+
+    // drop expired entries and those of devices that changed their address
+
+    for (size_t i=0; i<devices.size(); i++)
+    {
+      const auto key=std::make_pair(devices[i].getMAC(), devices[i].getIfaceName());
+      const auto it=entries.find(key);
+
+      if (it != entries.end() && it->second.ip == devices[i].getIP() &&
+          it->second.mode == mode &&
+          now-it->second.time < (it->second.reachable ? ttl : negative_ttl))
+      {
+        result[i]=it->second.reachable;
+        hits++;
+        continue;
+      }
+
+      if (it != entries.end())
+      {
+        entries.erase(it);
+      }
+
+      ip.push_back(devices[i].getIP());
+      probed.push_back(i);
+      misses++;
+    }
+  }
+
+  if (ip.empty())
+  {
+    return result;
+  }
+
+  // probing is done without holding the lock
+
+  const std::vector<bool> reachable=checkReachability(ip, mode, timeout);
+
+  for (size_t k=0; k<probed.size(); k++)
+  {
+    result[probed[k]]=reachable[k];
+  }
+
+  // results are only stored if the cache has not been cleared or
+  // invalidated in the meantime, since they may be outdated then
+
+  std::lock_guard<std::mutex> lock(mtx);
+
+  if (generation != start_generation)
+  {
+    return result;
+  }
+
+  const clock::time_point now=clock::now();
+  for (size_t k=0; k<probed.size(); k++)
+  {
+    const DeviceInfo &info=devices[probed[k]];
+
+    Entry entry;
+    entry.ip=info.getIP();
+    entry.mode=mode;
+    entry.reachable=reachable[k];
+    entry.time=now;
+
+    entries[std::make_pair(info.getMAC(), info.getIfaceName())]=entry;
+  }
+
+  return result;
+}
+
+void ReachabilityCache::invalidate(uint64_t mac)
+{
+  std::lock_guard<std::mutex> lock(mtx);
+
+  generation++;
+
+  auto it=entries.lower_bound(std::make_pair(mac, std::string()));
+  while (it != entries.end() && it->first.first == mac)
+  {
+    it=entries.erase(it);
+  }
+}
+
+void ReachabilityCache::clear()
+{
+  std::lock_guard<std::mutex> lock(mtx);
+  generation++;
+  entries.clear();
+}
+
+uint64_t ReachabilityCache::getHits() const
+{
+  std::lock_guard<std::mutex> lock(mtx);
+  return hits;
+}
+
+uint64_t ReachabilityCache::getMisses() const
+{
+  std::lock_guard<std::mutex> lock(mtx);
+  return misses;
+}
+
+}
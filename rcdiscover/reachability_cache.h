@@ -0,0 +1,151 @@
+/*
+ * rcdiscover - the network discovery tool for Roboception devices
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef RCDISCOVER_REACHABILITY_CACHE_H
+#define RCDISCOVER_REACHABILITY_CACHE_H
+
+#include "deviceinfo.h"
+#include "ping.h"
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <cstdint>
+
+namespace rcdiscover
+{
+
+/**
+ * @brief Cache of reachability results, so that repeated discoveries only
+ * probe new or changed devices.
+ *
+ * Results are kept per MAC address and interface for a configurable time.
+ * An entry is only used if the IP address and the reachability mode are
+ * the same as when it was probed, i.e. it is invalidated as soon as the
+ * device is discovered with another IP address. Negative results are kept
+ * for a shorter time than positive ones, since unreachable devices may
+ * become reachable at any time, e.g. after booting. All methods are thread
+ * safe.
+ */
+class ReachabilityCache
+{
+  public:
+    /**
+     * @brief Constructor.
+     * @param ttl time to live of results of reachable devices in milliseconds
+     * @param negative_ttl time to live of results of unreachable devices in
+     *                     milliseconds
+     */
+    explicit ReachabilityCache(int ttl=10000, int negative_ttl=2000);
+
+    /**
+     * @brief Sets the time to live of results of reachable devices. A value
+     * of 0 disables caching them.
+     * @param ttl time to live in milliseconds
+     */
+    void setTTL(int ttl);
+
+    /**
+     * @brief Sets the time to live of results of unreachable devices. A
+     * value of 0 disables caching them.
+     * @param ttl time to live in milliseconds
+     */
+    void setNegativeTTL(int ttl);
+
+    /**
+     * @brief Returns the reachability of all devices. Only devices without
+     * valid cached result are probed, all of them at once.
+     * @param devices devices to be checked
+     * @param mode method for checking reachability
+     * @param timeout time in milliseconds to wait for replies
+     * @return whether the device with the same index is reachable
+     */
+    std::vector<bool> check(const std::vector<DeviceInfo> &devices,
+                            ReachabilityMode mode=ReachabilityMode::ICMP,
+                            int timeout=1000);
+
+    /**
+     * @brief Removes all results of a device, e.g. because it is reset.
+     * Results of probes that are running at the same time are not stored.
+     * @param mac MAC address of the device
+     */
+    void invalidate(uint64_t mac);
+
+    /**
+     * @brief Removes all results. Results of probes that are running at the
+     * same time are not stored.
+     */
+    void clear();
+
+    /**
+     * @brief Returns the number of devices that have been taken from the
+     * cache.
+     * @return number of hits
+     */
+    uint64_t getHits() const;
+
+    /**
+     * @brief Returns the number of devices that had to be probed.
+     * @return number of misses
+     */
+    uint64_t getMisses() const;
+
+  private:
+    typedef std::chrono::steady_clock clock;
+
+    struct Entry
+    {
+      uint32_t ip;
+      ReachabilityMode mode;
+      bool reachable;
+      clock::time_point time;
+    };
+
+    mutable std::mutex mtx;
+    std::chrono::milliseconds ttl;
+    std::chrono::milliseconds negative_ttl;
+    std::map<std::pair<uint64_t, std::string>, Entry> entries;
+
+    // incremented by clear() and invalidate() for discarding the results of
+    // probes that were started before
+    uint64_t generation;
+
+    uint64_t hits;
+    uint64_t misses;
+};
+
+}
+
+#endif // RCDISCOVER_REACHABILITY_CACHE_H
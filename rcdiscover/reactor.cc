@@ -0,0 +1,175 @@
+/*
+ * rcdiscover - the network discovery tool for Roboception devices
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "reactor.h"
+
+#include "socket_exception.h"
+
+#ifndef WIN32
+#include <sys/epoll.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <errno.h>
+
+namespace rcdiscover
+{
+
+#ifdef WIN32
+
+Reactor::Reactor()
+{ }
+
+Reactor::~Reactor()
+{ }
+
+void Reactor::add(HandleType handle, std::size_t id)
+{
+  WSAPOLLFD fd;
+  fd.fd=handle;
+  fd.events=POLLRDNORM;
+  fd.revents=0;
+
+  fds_.push_back(fd);
+  ids_.push_back(id);
+}
+
+void Reactor::clear()
+{
+  fds_.clear();
+  ids_.clear();
+}
+
+std::size_t Reactor::wait(std::vector<std::size_t> &ready, int timeout)
+{
+  ready.clear();
+
+  if (fds_.empty())
+  {
+    Sleep(static_cast<DWORD>(timeout > 0 ? timeout : 0));
+    return 0;
+  }
+
+  if (WSAPoll(fds_.data(), static_cast<ULONG>(fds_.size()), timeout > 0 ? timeout : 0) == SOCKET_ERROR)
+  {
+    throw SocketException("Error while waiting for data", WSAGetLastError());
+  }
+
+  for (std::size_t i=0; i<fds_.size(); i++)
+  {
+    if (fds_[i].revents != 0)
+    {
+      ready.push_back(ids_[i]);
+    }
+  }
+
+  return ready.size();
+}
+
+#else
+
+Reactor::Reactor() :
+  epoll_fd_(::epoll_create1(EPOLL_CLOEXEC)),
+  count_(0)
+{
+  if (epoll_fd_ == -1)
+  {
+    throw SocketException("Error while creating epoll instance", errno);
+  }
+}
+
+Reactor::~Reactor()
+{
+  ::close(epoll_fd_);
+}
+
+void Reactor::add(HandleType handle, std::size_t id)
+{
+  epoll_event ev;
+  ev.events=EPOLLIN;
+  ev.data.u64=id;
+
+  if (::epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, handle, &ev) == -1)
+  {
+    throw SocketException("Error while registering socket", errno);
+  }
+
+  count_++;
+}
+
+void Reactor::clear()
+{
+  // a new instance also drops sockets that are still open
+
+  const int fd=::epoll_create1(EPOLL_CLOEXEC);
+  if (fd == -1)
+  {
+    throw SocketException("Error while creating epoll instance", errno);
+  }
+
+  ::close(epoll_fd_);
+  epoll_fd_=fd;
+  count_=0;
+}
+
+std::size_t Reactor::wait(std::vector<std::size_t> &ready, int timeout)
+{
+  ready.clear();
+
+  epoll_event events[64];
+  const int max_events=static_cast<int>(std::min<std::size_t>(64, std::max<std::size_t>(1, count_)));
+
+  const int n=::epoll_wait(epoll_fd_, events, max_events, std::max(0, timeout));
+
+  if (n == -1)
+  {
+    if (errno == EINTR)
+    {
+      return 0;
+    }
+
+    throw SocketException("Error while waiting for data", errno);
+  }
+
+  for (int i=0; i<n; i++)
+  {
+    ready.push_back(static_cast<std::size_t>(events[i].data.u64));
+  }
+
+  return ready.size();
+}
+
+#endif
+
+}
@@ -0,0 +1,112 @@
+/*
+ * rcdiscover - the network discovery tool for Roboception devices
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef RCDISCOVER_REACTOR_H
+#define RCDISCOVER_REACTOR_H
+
+#include <vector>
+#include <cstddef>
+
+#ifdef WIN32
+#include <winsock2.h>
+#endif
+
+namespace rcdiscover
+{
+
+/**
+ * @brief Event loop that waits for incoming data on a set of sockets.
+ *
+ * The sockets are registered once and stay registered for the lifetime of
+ * the reactor, so that waiting does not require any per-call setup. On Linux,
+ * epoll is used, on Windows WSAPoll. In contrast to select(), there is no
+ * limit on the number of sockets or on the value of the socket handles.
+ */
+class Reactor
+{
+  public:
+    /**
+     * @brief Type representing the native socket handle type.
+     */
+#ifdef WIN32
+    typedef SOCKET HandleType;
+#else
+    typedef int HandleType;
+#endif
+
+  public:
+    /**
+     * @brief Constructor.
+     * @throws SocketException if the event loop cannot be created
+     */
+    Reactor();
+    ~Reactor();
+
+    Reactor(const Reactor &) = delete;
+    Reactor &operator=(const Reactor &) = delete;
+
+    /**
+     * @brief Registers a socket for read events.
+     * @param handle native socket handle
+     * @param id user defined id that is reported by wait() if the socket
+     * becomes readable
+     */
+    void add(HandleType handle, std::size_t id);
+
+    /**
+     * @brief Removes all registered sockets.
+     * @throws SocketException if the event loop cannot be recreated
+     */
+    void clear();
+
+    /**
+     * @brief Waits until at least one registered socket becomes readable.
+     * @param ready cleared and filled with the ids of all readable sockets
+     * @param timeout timeout in milliseconds
+     * @return number of readable sockets, 0 in case of a timeout
+     */
+    std::size_t wait(std::vector<std::size_t> &ready, int timeout);
+
+  private:
+#ifdef WIN32
+    std::vector<WSAPOLLFD> fds_;
+    std::vector<std::size_t> ids_;
+#else
+    int epoll_fd_;
+    std::size_t count_;
+#endif
+};
+
+}
+
+#endif // RCDISCOVER_REACTOR_H
@@ -0,0 +1,107 @@
+/*
+ * rcdiscover - the network discovery tool for Roboception devices
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "request_table.h"
+
+#include "gige_request_counter.h"
+
+#include <algorithm>
+#include <tuple>
+
+namespace rcdiscover
+{
+
+RequestTable::RequestTable() : slots_(65536)
+{
+  // slots with generation 0 are never valid
+
+  for (auto &slot : slots_)
+  {
+    slot.generation=0;
+  }
+
+  generation_[Broadcast]=1;
+  generation_[Unicast]=1;
+}
+
+uint16_t RequestTable::add(Kind kind, int round)
+{
+  uint8_t hi, lo;
+  std::tie(hi, lo)=GigERequestCounter::getNext();
+  const uint16_t id=static_cast<uint16_t>((hi<<8)|lo);
+
+  Slot &slot=slots_[id];
+  slot.sent=std::chrono::steady_clock::now();
+  slot.generation=generation_[kind];
+  slot.round=static_cast<uint8_t>(std::min(round, 255));
+  slot.kind=static_cast<uint8_t>(kind);
+
+  return id;
+}
+
+bool RequestTable::find(uint16_t id, Request &request) const
+{
+  const Slot &slot=slots_[id];
+
+  if (slot.generation == 0 || slot.generation != generation_[slot.kind])
+  {
+    return false;
+  }
+
+  request.sent=slot.sent;
+  request.round=slot.round;
+
+  return true;
+}
+
+void RequestTable::clear(Kind kind)
+{
+  generation_[kind]++;
+
+  if (generation_[kind] == 0)
+  {
+    // invalidate all slots explicitly on wrap around
+
+    for (auto &slot : slots_)
+    {
+      if (slot.kind == kind)
+      {
+        slot.generation=0;
+      }
+    }
+
+    generation_[kind]=1;
+  }
+}
+
+}
@@ -0,0 +1,109 @@
+/*
+ * rcdiscover - the network discovery tool for Roboception devices
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef RCDISCOVER_REQUEST_TABLE_H
+#define RCDISCOVER_REQUEST_TABLE_H
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include <chrono>
+
+namespace rcdiscover
+{
+
+/**
+ * @brief Table of sent GVCP requests, directly indexed by the 16 bit
+ * request id.
+ *
+ * Looking up the request of a received acknowledge is O(1), independent of
+ * the number of requests that have been sent. Requests are grouped into
+ * kinds, which can be cleared independently of each other in O(1).
+ */
+class RequestTable
+{
+  public:
+
+    enum Kind
+    {
+      Broadcast=0,
+      Unicast=1
+    };
+
+    struct Request
+    {
+      std::chrono::steady_clock::time_point sent;
+      int round;
+    };
+
+    RequestTable();
+
+    /**
+     * @brief Gets the next request id and records the request as sent now.
+     * @param kind kind of request
+     * @param round round of the request, starting with 1
+     * @return request id
+     */
+    uint16_t add(Kind kind, int round);
+
+    /**
+     * @brief Looks up a request.
+     * @param id request id
+     * @param request filled with the data of the request if found
+     * @return true if the request is in the table
+     */
+    bool find(uint16_t id, Request &request) const;
+
+    /**
+     * @brief Removes all requests of the given kind.
+     * @param kind kind of request
+     */
+    void clear(Kind kind);
+
+  private:
+
+    struct Slot
+    {
+      std::chrono::steady_clock::time_point sent;
+      uint32_t generation;
+      uint8_t round;
+      uint8_t kind;
+    };
+
+    std::vector<Slot> slots_;
+    uint32_t generation_[2];
+};
+
+}
+
+#endif // RCDISCOVER_REQUEST_TABLE_H
@@ -0,0 +1,484 @@
+/*
+ * rcdiscover - the network discovery tool for Roboception devices
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "route_table.h"
+
+#include "socket_exception.h"
+
+#ifdef WIN32
+#include <winsock2.h>
+#include <iphlpapi.h>
+#include <map>
+#else
+#include <sys/socket.h>
+#include <linux/netlink.h>
+#include <linux/rtnetlink.h>
+#include <net/if.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#include <errno.h>
+#endif
+
+#include <algorithm>
+#include <cstring>
+
+namespace rcdiscover
+{
+
+#ifdef WIN32
+
+namespace
+{
+
+std::map<DWORD, std::string> getAdapterNames()
+{
+  ULONG buflen=0;
+  std::vector<uint8_t> buffer;
+
+  std::map<DWORD, std::string> result;
+  if (GetAdaptersInfo(nullptr, &buflen) != ERROR_BUFFER_OVERFLOW)
+  {
+    return result;
+  }
+
+  buffer.resize(buflen);
+  PIP_ADAPTER_INFO adapter=reinterpret_cast<PIP_ADAPTER_INFO>(buffer.data());
+  if (GetAdaptersInfo(adapter, &buflen) == NO_ERROR)
+  {
+    while (adapter)
+    {
+      result.emplace(adapter->Index, adapter->AdapterName);
+      adapter=adapter->Next;
+    }
+  }
+
+  return result;
+}
+
+}
+
+RouteTable RouteTable::load()
+{
+  ULONG size=0;
+  std::vector<uint8_t> buffer;
+
+  DWORD ret;
+  do
+  {
+    buffer.resize(size);
+    ret=GetIpForwardTable(reinterpret_cast<PMIB_IPFORWARDTABLE>(
+      buffer.empty() ? nullptr : buffer.data()), &size, FALSE);
+  }
+  while (ret == ERROR_INSUFFICIENT_BUFFER);
+
+  if (ret != NO_ERROR)
+  {
+    throw SocketException("Unable to read routing table", ret);
+  }
+
+  const std::map<DWORD, std::string> names=getAdapterNames();
+
+  RouteTable table;
+  const PMIB_IPFORWARDTABLE t=reinterpret_cast<PMIB_IPFORWARDTABLE>(buffer.data());
+  for (DWORD i=0; i<t->dwNumEntries; i++)
+  {
+    const MIB_IPFORWARDROW &row=t->table[i];
+
+    if (row.dwForwardType != MIB_IPROUTE_TYPE_DIRECT &&
+        row.dwForwardType != MIB_IPROUTE_TYPE_INDIRECT)
+    {
+      continue;
+    }
+
+    // the next hop of direct routes is the address of the interface
+
+    Route route;
+    route.dst=ntohl(row.dwForwardDest);
+    route.mask=ntohl(row.dwForwardMask);
+    route.metric=row.dwForwardMetric1;
+    route.reject=false;
+
+    if (row.dwForwardType == MIB_IPROUTE_TYPE_DIRECT)
+    {
+      route.gateway=0;
+      route.src=ntohl(row.dwForwardNextHop);
+    }
+    else
+    {
+      route.gateway=ntohl(row.dwForwardNextHop);
+      route.src=0;
+    }
+
+    const auto name=names.find(row.dwForwardIfIndex);
+    if (name != names.end())
+    {
+      route.iface=name->second;
+    }
+
+    table.addRoute(route);
+  }
+
+  table.finish();
+
+  return table;
+}
+
+#else
+
+namespace
+{
+
+uint32_t prefix2mask(int prefix)
+{
+  return prefix <= 0 ? 0 : (prefix >= 32 ? 0xffffffff :
+    ~((static_cast<uint32_t>(1) << (32-prefix))-1));
+}
+
+}
+
+RouteTable RouteTable::load()
+{
+  int fd=::socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC, NETLINK_ROUTE);
+  if (fd < 0)
+  {
+    throw SocketException("Unable to create netlink socket", errno);
+  }
+
+  struct
+  {
+    nlmsghdr nh;
+    rtmsg rt;
+  } req;
+
+  memset(&req, 0, sizeof(req));
+  req.nh.nlmsg_len=NLMSG_LENGTH(sizeof(rtmsg));
+  req.nh.nlmsg_type=RTM_GETROUTE;
+  req.nh.nlmsg_flags=NLM_F_REQUEST | NLM_F_DUMP;
+  req.nh.nlmsg_seq=1;
+  req.rt.rtm_family=AF_INET;
+
+  if (::send(fd, &req, req.nh.nlmsg_len, 0) < 0)
+  {
+    const int err=errno;
+    ::close(fd);
+    throw SocketException("Unable to request routing table", err);
+  }
+
+  RouteTable table;
+
+  // the dump consists of several messages and is terminated by NLMSG_DONE
+
+  bool done=false;
+  std::vector<uint8_t> buffer(32768);
+  while (!done)
+  {
+    const ssize_t n=::recv(fd, buffer.data(), buffer.size(), 0);
+    if (n < 0)
+    {
+      if (errno == EINTR)
+      {
+        continue;
+      }
+
+      const int err=errno;
+      ::close(fd);
+      throw SocketException("Unable to read routing table", err);
+    }
+
+    int len=static_cast<int>(n);
+    for (nlmsghdr *nh=reinterpret_cast<nlmsghdr *>(buffer.data());
+         NLMSG_OK(nh, len); nh=NLMSG_NEXT(nh, len))
+    {
+      if (nh->nlmsg_type == NLMSG_DONE)
+      {
+        done=true;
+        break;
+      }
+
+      if (nh->nlmsg_type == NLMSG_ERROR)
+      {
+        const nlmsgerr *e=reinterpret_cast<const nlmsgerr *>(NLMSG_DATA(nh));
+        ::close(fd);
+        throw SocketException("Unable to read routing table", -e->error);
+      }
+
+      if (nh->nlmsg_type != RTM_NEWROUTE)
+      {
+        continue;
+      }
+
+      const rtmsg *rt=reinterpret_cast<const rtmsg *>(NLMSG_DATA(nh));
+
+      uint32_t rt_table=rt->rtm_table;
+      int oif=0;
+
+      Route route;
+      route.dst=0;
+      route.mask=prefix2mask(rt->rtm_dst_len);
+      route.gateway=0;
+      route.src=0;
+      route.metric=0;
+
+      int attr_len=static_cast<int>(RTM_PAYLOAD(nh));
+      for (const rtattr *attr=RTM_RTA(rt); RTA_OK(attr, attr_len);
+           attr=RTA_NEXT(attr, attr_len))
+      {
+        const void *data=RTA_DATA(attr);
+
+        switch (attr->rta_type)
+        {
+          case RTA_TABLE:
+            memcpy(&rt_table, data, sizeof(rt_table));
+            break;
+
+          case RTA_DST:
+            memcpy(&route.dst, data, sizeof(route.dst));
+            route.dst=ntohl(route.dst);
+            break;
+
+          case RTA_GATEWAY:
+            memcpy(&route.gateway, data, sizeof(route.gateway));
+            route.gateway=ntohl(route.gateway);
+            break;
+
+          case RTA_PREFSRC:
+            memcpy(&route.src, data, sizeof(route.src));
+            route.src=ntohl(route.src);
+            break;
+
+          case RTA_OIF:
+            memcpy(&oif, data, sizeof(oif));
+            break;
+
+          case RTA_PRIORITY:
+            memcpy(&route.metric, data, sizeof(route.metric));
+            break;
+
+          case RTA_MULTIPATH:
+            {
+              // only the first next hop is considered
+
+              const rtnexthop *nhop=reinterpret_cast<const rtnexthop *>(data);
+              if (RTA_PAYLOAD(attr) >= sizeof(rtnexthop))
+              {
+                oif=nhop->rtnh_ifindex;
+
+                int nhop_len=static_cast<int>(nhop->rtnh_len-sizeof(rtnexthop));
+                for (const rtattr *a=RTNH_DATA(nhop); RTA_OK(a, nhop_len);
+                     a=RTA_NEXT(a, nhop_len))
+                {
+                  if (a->rta_type == RTA_GATEWAY)
+                  {
+                    memcpy(&route.gateway, RTA_DATA(a), sizeof(route.gateway));
+                    route.gateway=ntohl(route.gateway);
+                  }
+                }
+              }
+            }
+            break;
+
+          default:
+            break;
+        }
+      }
+
+      if (rt_table != RT_TABLE_MAIN)
+      {
+        continue;
+      }
+
+      if (rt->rtm_type == RTN_UNICAST)
+      {
+        route.reject=false;
+      }
+      else if (rt->rtm_type == RTN_UNREACHABLE ||
+               rt->rtm_type == RTN_BLACKHOLE ||
+               rt->rtm_type == RTN_PROHIBIT)
+      {
+        route.reject=true;
+      }
+      else
+      {
+        continue;
+      }
+
+      char name[IF_NAMESIZE];
+      if (oif > 0 && if_indextoname(static_cast<unsigned int>(oif), name))
+      {
+        route.iface=name;
+      }
+
+      table.addRoute(route);
+    }
+  }
+
+  ::close(fd);
+
+  table.finish();
+
+  return table;
+}
+
+#endif
+
+void RouteTable::addRoute(const Route &route)
+{
+  routes.push_back(route);
+  routes.back().dst&=route.mask;
+}
+
+void RouteTable::finish()
+{
+  // routes via gateways usually do not have a preferred source address, in
+  // which case the address of the interface towards the gateway is used
+
+  for (Route &route : routes)
+  {
+    if (route.src == 0 && route.gateway != 0)
+    {
+      for (const Route &link : routes)
+      {
+        if (link.gateway == 0 && link.src != 0 && link.iface == route.iface &&
+            (route.gateway & link.mask) == link.dst)
+        {
+          route.src=link.src;
+          break;
+        }
+      }
+    }
+  }
+
+  // the longest prefix with the lowest metric is found first
+
+  std::stable_sort(routes.begin(), routes.end(),
+                   [](const Route &a, const Route &b)
+  {
+    if (a.mask != b.mask)
+    {
+      return a.mask > b.mask;
+    }
+
+    return a.metric < b.metric;
+  });
+}
+
+const RouteTable::Route *RouteTable::lookup(uint32_t ip) const
+{
+  for (const Route &route : routes)
+  {
+    if ((ip & route.mask) == route.dst)
+    {
+      return &route;
+    }
+  }
+
+  return nullptr;
+}
+
+RouteTable::Classification RouteTable::classify(uint32_t ip,
+                                                const std::string &iface) const
+{
+  Classification ret;
+  ret.type=Type::Unroutable;
+  ret.gateway=0;
+
+  if (ip == 0)
+  {
+    ret.reason="no IP address";
+    return ret;
+  }
+
+  const Route *route=lookup(ip);
+
+  if (route == nullptr)
+  {
+    ret.reason="no route";
+    return ret;
+  }
+
+  ret.iface=route->iface;
+
+  if (route->reject)
+  {
+    ret.reason="rejected by route";
+    return ret;
+  }
+
+  if (!iface.empty() && route->iface != iface)
+  {
+    ret.reason="routed via other interface";
+    return ret;
+  }
+
+  if (route->gateway == 0)
+  {
+    ret.type=Type::OnLink;
+    ret.reason="on link";
+  }
+  else
+  {
+    ret.type=Type::Gateway;
+    ret.gateway=route->gateway;
+    ret.reason="via gateway";
+  }
+
+  return ret;
+}
+
+RouteTable::Classification RouteTable::classify(const DeviceInfo &info) const
+{
+  Classification ret=classify(info.getIP(), info.getIfaceName());
+
+  if (ret.type == Type::Unroutable)
+  {
+    return ret;
+  }
+
+  // the device must be able to send its replies back to the source address
+  // of the host, either directly or via its gateway
+
+  const Route *route=lookup(info.getIP());
+  const uint32_t mask=info.getSubnetMask();
+
+  if (route->src != 0 && (route->src & mask) != (info.getIP() & mask) &&
+      info.getGateway() == 0)
+  {
+    ret.type=Type::Unroutable;
+    ret.gateway=0;
+    ret.reason="host outside of device subnet";
+  }
+
+  return ret;
+}
+
+}
@@ -0,0 +1,135 @@
+/*
+ * rcdiscover - the network discovery tool for Roboception devices
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef RCDISCOVER_ROUTE_TABLE_H
+#define RCDISCOVER_ROUTE_TABLE_H
+
+#include "deviceinfo.h"
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace rcdiscover
+{
+
+/**
+ * @brief Snapshot of the IPv4 routing table of the host for classifying
+ * whether devices are reachable without sending any packets.
+ *
+ * The table is read once via netlink on Linux and via GetIpForwardTable() on
+ * Windows. Afterwards, classifying an address is a longest prefix match in
+ * memory. Only the main routing table is considered, i.e. policy routing
+ * rules are ignored.
+ */
+class RouteTable
+{
+  public:
+    /**
+     * @brief Way in which an address can be reached.
+     */
+    enum class Type
+    {
+      OnLink,     ///< directly on the link of an interface
+      Gateway,    ///< via a gateway
+      Unroutable  ///< not at all
+    };
+
+    /**
+     * @brief Outcome of classifying an address.
+     */
+    struct Classification
+    {
+      Type type;
+      uint32_t gateway;    ///< next hop in host byte order, if type is Gateway
+      std::string iface;   ///< outgoing interface, empty if there is no route
+      const char *reason;  ///< short explanation, which is a static string
+    };
+
+  public:
+    /**
+     * @brief Reads the current routing table of the host.
+     * @return route table
+     * @throws SocketException if the routing table cannot be read
+     */
+    static RouteTable load();
+
+    /**
+     * @brief Classifies how the host would send packets to the address.
+     * @param ip IP address in host byte order
+     * @param iface interface on which the address is expected, e.g. the one
+     *        on which a device answered. Routes via other interfaces are
+     *        reported as unroutable. Any interface is accepted if empty.
+     * @return classification
+     */
+    Classification classify(uint32_t ip,
+                            const std::string &iface=std::string()) const;
+
+    /**
+     * @brief Classifies a device by its address and the interface on which
+     * it answered. Additionally, it is checked whether the device is able to
+     * reply according to its subnet mask and gateway.
+     * @param info device info
+     * @return classification
+     */
+    Classification classify(const DeviceInfo &info) const;
+
+    /**
+     * @brief Returns the number of routes.
+     * @return number of routes
+     */
+    size_t size() const { return routes.size(); }
+
+  private:
+    struct Route
+    {
+      uint32_t dst;
+      uint32_t mask;
+      uint32_t gateway;
+      uint32_t src;
+      uint32_t metric;
+      std::string iface;
+      bool reject;
+    };
+
+    void addRoute(const Route &route);
+    void finish();
+
+    const Route *lookup(uint32_t ip) const;
+
+    std::vector<Route> routes;
+};
+
+}
+
+#endif // RCDISCOVER_ROUTE_TABLE_H
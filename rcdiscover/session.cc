@@ -0,0 +1,82 @@
+/*
+ * rcdiscover - the network discovery tool for Roboception devices
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "session.h"
+
+#include "discover.h"
+#include "force_ip.h"
+#include "wol.h"
+
+namespace rcdiscover
+{
+
+Session::Session(const InterfaceFilter &filter, SocketMode mode) :
+  cache_(std::make_shared<InterfaceCache>(3956, mode, filter))
+{ }
+
+Session::~Session()
+{ }
+
+Discover &Session::getDiscover()
+{
+  if (!discover_)
+  {
+    discover_.reset(new Discover(cache_));
+  }
+
+  return *discover_;
+}
+
+ForceIP &Session::getForceIP()
+{
+  if (!force_ip_)
+  {
+    force_ip_.reset(new ForceIP(cache_));
+  }
+
+  return *force_ip_;
+}
+
+WOL Session::createWOL(uint64_t hardware_addr, uint16_t port) const
+{
+  return WOL(hardware_addr, port, cache_);
+}
+
+void Session::sendWOL(
+    const std::vector<std::pair<uint64_t, std::array<uint8_t, 4>>> &targets,
+    uint16_t port) const
+{
+  WOL::sendBatch(targets, port, cache_);
+}
+
+}
@@ -0,0 +1,124 @@
+/*
+ * rcdiscover - the network discovery tool for Roboception devices
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef RCDISCOVER_SESSION_H
+#define RCDISCOVER_SESSION_H
+
+#include "interface_cache.h"
+#include "interface_filter.h"
+
+#include <array>
+#include <vector>
+#include <memory>
+#include <utility>
+#include <cstdint>
+
+namespace rcdiscover
+{
+
+class Discover;
+class ForceIP;
+class WOL;
+
+/**
+ * @brief Owns one set of sockets for all interfaces and shares it between
+ * discovery, FORCEIP commands and magic packets.
+ *
+ * Bulk operations on many devices only need to enumerate interfaces and
+ * bind sockets once. The sockets are recreated automatically if interfaces
+ * change. A session must not be used by several threads at the same time.
+ */
+class Session
+{
+  public:
+    /**
+     * @brief Constructor. Creates the sockets of all selected interfaces.
+     * @param filter selection of interfaces
+     * @param mode number of sockets per interface
+     */
+    explicit Session(const InterfaceFilter &filter=InterfaceFilter(),
+                     SocketMode mode=SocketMode::ThreePerInterface);
+    ~Session();
+
+    Session(const Session &) = delete;
+    Session &operator=(const Session &) = delete;
+
+    /**
+     * @brief Returns the discovery object of the session, which is created
+     * on first use.
+     * @return discovery object
+     */
+    Discover &getDiscover();
+
+    /**
+     * @brief Returns the FORCEIP object of the session, which is created on
+     * first use.
+     * @return FORCEIP object
+     */
+    ForceIP &getForceIP();
+
+    /**
+     * @brief Creates a magic packet sender that uses the sockets of the
+     * session.
+     * @param hardware_addr MAC-address of device
+     * @param port destination UDP port
+     * @return magic packet sender
+     */
+    WOL createWOL(uint64_t hardware_addr, uint16_t port=9) const;
+
+    /**
+     * @brief Sends magic packets with data to many devices at once with the
+     * sockets of the session.
+     * @param targets MAC-addresses of devices and the data to send to them
+     * @param port destination UDP port
+     */
+    void sendWOL(
+        const std::vector<std::pair<uint64_t, std::array<uint8_t, 4>>> &targets,
+        uint16_t port=9) const;
+
+    /**
+     * @brief Returns the interface cache that holds the sockets.
+     * @return interface cache
+     */
+    const std::shared_ptr<InterfaceCache> &getInterfaceCache() const
+    { return cache_; }
+
+  private:
+    std::shared_ptr<InterfaceCache> cache_;
+    std::unique_ptr<Discover> discover_;
+    std::unique_ptr<ForceIP> force_ip_;
+};
+
+}
+
+#endif // RCDISCOVER_SESSION_H
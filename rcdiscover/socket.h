@@ -45,6 +45,26 @@ struct sockaddr_in;
 namespace rcdiscover
 {
 
+/**
+ * @brief Strategy for creating the sockets of all interfaces.
+ */
+enum class SocketMode
+{
+  /**
+   * Three sockets per interface: a limited broadcast sender, a limited
+   * broadcast receiver and a directed broadcast socket.
+   */
+  ThreePerInterface,
+
+  /**
+   * One socket per interface that sends the limited and the directed
+   * broadcast and selects the outgoing interface and source address via
+   * IP_PKTINFO. Only available on Linux. Other platforms fall back to their
+   * default.
+   */
+  OnePerInterface
+};
+
 /**
  * CRTP class for platform specific socket implementation.
  */
@@ -97,7 +117,43 @@ class Socket
      */
     void send(const std::vector<uint8_t>& sendbuf)
     {
-      getDerived().sendImpl(sendbuf);
+      getDerived().sendImpl(sendbuf, 0);
+    }
+
+    /**
+     * @brief Sends data to the destination address of this socket, but to
+     * another port.
+     * @param sendbuf data to send
+     * @param port destination port
+     */
+    void send(const std::vector<uint8_t>& sendbuf, uint16_t port)
+    {
+      getDerived().sendImpl(sendbuf, port);
+    }
+
+    /**
+     * @brief Sends a batch of packets of equal size, which are stored one
+     * after another in a contiguous buffer, to the destination address of
+     * this socket with as few system calls as possible.
+     * @param buffer packets
+     * @param packet_size size of each packet
+     * @param port destination port or 0 for the port of this socket
+     */
+    void sendBatch(const std::vector<uint8_t>& buffer, size_t packet_size,
+                   uint16_t port=0)
+    {
+      getDerived().sendBatchImpl(buffer, packet_size, port);
+    }
+
+    /**
+     * @brief Sends data to a unicast address instead of the destination
+     * address of this socket. The destination port stays the same.
+     * @param sendbuf data to send
+     * @param ip destination IP address in host byte order
+     */
+    void sendTo(const std::vector<uint8_t>& sendbuf, uint32_t ip)
+    {
+      getDerived().sendToImpl(sendbuf, ip);
     }
 
     /**
@@ -48,9 +48,11 @@
 #include <netinet/ether.h>
 #include <ifaddrs.h>
 #include <fcntl.h>
+#include <poll.h>
 
 #include <iostream>
 #include <algorithm>
+#include <cstring>
 
 namespace rcdiscover
 {
@@ -74,7 +76,7 @@ SocketLinux SocketLinux::create(const in_addr_t dst_ip, const uint16_t port,
 }
 
 std::vector<SocketLinux> SocketLinux::createAndBindForAllInterfaces(
-    const uint16_t port)
+    const uint16_t port, const SocketMode mode, const InterfaceFilter &filter)
 {
   std::vector<SocketLinux> sockets;
 
@@ -95,12 +97,33 @@ std::vector<SocketLinux> SocketLinux::createAndBindForAllInterfaces(
         baddr != nullptr)
     {
       std::string name(addr->ifa_name);
-      if (name.length() != 0 && name != "lo")
+      if (name.length() != 0 && name != "lo" && filter.accepts(name))
       {
         const in_addr_t s_addr =
             reinterpret_cast<struct sockaddr_in *>(addr->ifa_addr)->
             sin_addr.s_addr;
 
+        if (mode == SocketMode::OnePerInterface)
+        {
+          // one socket for limited and directed broadcast, which receives
+          // all responses on its own port
+
+          sockets.emplace_back(SocketLinux::create(getBroadcastAddr(), port, name));
+
+          sockaddr_in addr;
+          addr.sin_family = AF_INET;
+          addr.sin_port = 0;
+          addr.sin_addr.s_addr = htonl(INADDR_ANY);
+          sockets.back().bind(addr);
+
+          sockets.back().setSendInterface(
+                static_cast<int>(if_nametoindex(name.c_str())), s_addr,
+                reinterpret_cast<struct sockaddr_in *>(baddr)->sin_addr.s_addr);
+
+          ++i;
+          continue;
+        }
+
         uint16_t local_port = 0;
 
         {
@@ -164,7 +187,10 @@ SocketLinux::SocketLinux(int domain, int type, int protocol,
                          std::string iface_name) :
   Socket(std::move(iface_name)),
   sock_(-1),
-  dst_addr_()
+  dst_addr_(),
+  ifindex_(0),
+  src_ip_(0),
+  directed_ip_(0)
 {
   sock_ = ::socket(domain, type, protocol);
   if (sock_ == -1)
@@ -174,6 +200,13 @@ SocketLinux::SocketLinux(int domain, int type, int protocol,
       throw OperationNotPermitted();
     }
 
+    if (errno == EMFILE)
+    {
+      throw SocketException("Error while creating socket: limit of open "
+                            "files reached, it can be raised with ulimit -n",
+                            errno);
+    }
+
     throw SocketException("Error while creating socket", errno);
   }
 
@@ -195,7 +228,10 @@ SocketLinux::SocketLinux(int domain, int type, int protocol,
 SocketLinux::SocketLinux(SocketLinux &&other) :
   Socket(std::move(other)),
   sock_(-1),
-  dst_addr_(std::move(other.dst_addr_))
+  dst_addr_(std::move(other.dst_addr_)),
+  ifindex_(other.ifindex_),
+  src_ip_(other.src_ip_),
+  directed_ip_(other.directed_ip_)
 {
   std::swap(sock_, other.sock_);
 }
@@ -203,6 +239,10 @@ SocketLinux::SocketLinux(SocketLinux &&other) :
 SocketLinux &SocketLinux::operator=(SocketLinux &&other)
 {
   std::swap(sock_, other.sock_);
+  std::swap(dst_addr_, other.dst_addr_);
+  std::swap(ifindex_, other.ifindex_);
+  std::swap(src_ip_, other.src_ip_);
+  std::swap(directed_ip_, other.directed_ip_);
   return *this;
 }
 
@@ -229,13 +269,197 @@ void SocketLinux::bindImpl(const ::sockaddr_in& addr)
   }
 }
 
-void SocketLinux::sendImpl(const std::vector<uint8_t>& sendbuf)
+void SocketLinux::sendImpl(const std::vector<uint8_t>& sendbuf,
+                           const uint16_t port)
+{
+  sockaddr_in dst_addr = dst_addr_;
+  if (port != 0)
+  {
+    dst_addr.sin_port = htons(port);
+  }
+
+  if (ifindex_ > 0)
+  {
+    // limited and directed broadcast via the interface of this socket
+
+    sockaddr_in directed_addr = dst_addr;
+    directed_addr.sin_addr.s_addr = directed_ip_;
+
+    // it is sufficient if one of both broadcasts could be sent
+
+    const int err = sendViaInterface(sendbuf, dst_addr);
+    const int err_directed = sendViaInterface(sendbuf, directed_addr);
+
+    if (err == 0 || err_directed == 0)
+    {
+      return;
+    }
+
+    if (err == ENETUNREACH)
+    {
+      throw NetworkUnreachableException(
+            "Error while sending data - network unreachable", err);
+    }
+
+    throw SocketException("Error while sending data", err);
+  }
+
+  sendToAddr(sendbuf, dst_addr);
+}
+
+void SocketLinux::sendBatchImpl(const std::vector<uint8_t> &buffer,
+                                const size_t packet_size, const uint16_t port)
+{
+  if (packet_size == 0)
+  {
+    return;
+  }
+
+  sockaddr_in dst[2];
+  int ndst = 1;
+
+  dst[0] = dst_addr_;
+  if (port != 0)
+  {
+    dst[0].sin_port = htons(port);
+  }
+
+  if (ifindex_ > 0)
+  {
+    // limited and directed broadcast via the interface of this socket
+
+    dst[1] = dst[0];
+    dst[1].sin_addr.s_addr = directed_ip_;
+    ndst = 2;
+  }
+
+  // the control message is the same for all packets
+
+  char control[CMSG_SPACE(sizeof(in_pktinfo))];
+  memset(control, 0, sizeof(control));
+
+  if (ifindex_ > 0)
+  {
+    msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+
+    cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_level = IPPROTO_IP;
+    cmsg->cmsg_type = IP_PKTINFO;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(in_pktinfo));
+
+    in_pktinfo *info = reinterpret_cast<in_pktinfo *>(CMSG_DATA(cmsg));
+    info->ipi_ifindex = ifindex_;
+    info->ipi_spec_dst.s_addr = src_ip_;
+  }
+
+  const size_t npackets = buffer.size()/packet_size;
+  const size_t n = npackets*static_cast<size_t>(ndst);
+
+  std::vector<iovec> iov(n);
+  std::vector<mmsghdr> msg(n);
+  memset(msg.data(), 0, n*sizeof(mmsghdr));
+
+  for (size_t i = 0; i < n; i++)
+  {
+    iov[i].iov_base = const_cast<uint8_t *>(buffer.data()) +
+                      (i % npackets)*packet_size;
+    iov[i].iov_len = packet_size;
+
+    msghdr &hdr = msg[i].msg_hdr;
+    hdr.msg_name = &dst[i/npackets];
+    hdr.msg_namelen = sizeof(sockaddr_in);
+    hdr.msg_iov = &iov[i];
+    hdr.msg_iovlen = 1;
+
+    if (ifindex_ > 0)
+    {
+      hdr.msg_control = control;
+      hdr.msg_controllen = sizeof(control);
+    }
+  }
+
+  // the kernel accepts at most UIO_MAXIOV messages per call and the socket
+  // is non-blocking, so wait until the send buffer has room again if needed
+
+  // with limited and directed broadcast, it is sufficient if one of both
+  // could be sent, like in sendImpl()
+
+  size_t sent = 0;
+  int err_limited = 0;
+  while (sent < n)
+  {
+    const unsigned int count =
+      static_cast<unsigned int>(std::min(n-sent, static_cast<size_t>(1024)));
+
+    const int ret = ::sendmmsg(sock_, &msg[sent], count, 0);
+    const int err = errno;
+
+    if (ret >= 0)
+    {
+      sent += static_cast<size_t>(ret);
+      continue;
+    }
+
+    if (err == EINTR)
+    {
+      continue;
+    }
+
+    if (err == EAGAIN || err == EWOULDBLOCK)
+    {
+      pollfd pfd;
+      pfd.fd = sock_;
+      pfd.events = POLLOUT;
+      pfd.revents = 0;
+
+      if (::poll(&pfd, 1, 100) > 0)
+      {
+        continue;
+      }
+    }
+
+    if (ndst == 2 && sent < npackets)
+    {
+      err_limited = err;
+      sent = npackets;
+      continue;
+    }
+
+    if (ndst == 2 && err_limited == 0)
+    {
+      return;
+    }
+
+    if (err == ENETUNREACH)
+    {
+      throw NetworkUnreachableException(
+            "Error while sending data - network unreachable", err);
+    }
+
+    throw SocketException("Error while sending data", err);
+  }
+}
+
+void SocketLinux::sendToImpl(const std::vector<uint8_t>& sendbuf,
+                             const uint32_t ip)
+{
+  sockaddr_in addr = dst_addr_;
+  addr.sin_addr.s_addr = htonl(ip);
+
+  sendToAddr(sendbuf, addr);
+}
+
+void SocketLinux::sendToAddr(const std::vector<uint8_t>& sendbuf,
+                             const sockaddr_in &addr)
 {
   if (::sendto(sock_,
               static_cast<const void *>(sendbuf.data()),
               sendbuf.size(),
               0,
-              reinterpret_cast<const sockaddr *>(&dst_addr_),
+              reinterpret_cast<const sockaddr *>(&addr),
               static_cast<socklen_t>(sizeof(sockaddr_in))) == -1)
    {
      if (errno == ENETUNREACH)
@@ -288,4 +512,55 @@ void SocketLinux::bindToDevice(const std::string &device)
   }
 }
 
+void SocketLinux::setSendInterface(int ifindex, in_addr_t src_ip,
+                                    in_addr_t directed_ip)
+{
+  if (ifindex <= 0)
+  {
+    throw SocketException("Error while getting interface index", errno);
+  }
+
+  ifindex_ = ifindex;
+  src_ip_ = src_ip;
+  directed_ip_ = directed_ip;
+}
+
+int SocketLinux::sendViaInterface(const std::vector<uint8_t> &sendbuf,
+                                  const sockaddr_in &dst)
+{
+  iovec iov;
+  iov.iov_base = const_cast<uint8_t *>(sendbuf.data());
+  iov.iov_len = sendbuf.size();
+
+  char control[CMSG_SPACE(sizeof(in_pktinfo))];
+  memset(control, 0, sizeof(control));
+
+  msghdr msg;
+  memset(&msg, 0, sizeof(msg));
+  msg.msg_name = const_cast<sockaddr_in *>(&dst);
+  msg.msg_namelen = sizeof(sockaddr_in);
+  msg.msg_iov = &iov;
+  msg.msg_iovlen = 1;
+  msg.msg_control = control;
+  msg.msg_controllen = sizeof(control);
+
+  // select outgoing interface and source address
+
+  cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+  cmsg->cmsg_level = IPPROTO_IP;
+  cmsg->cmsg_type = IP_PKTINFO;
+  cmsg->cmsg_len = CMSG_LEN(sizeof(in_pktinfo));
+
+  in_pktinfo *info = reinterpret_cast<in_pktinfo *>(CMSG_DATA(cmsg));
+  info->ipi_ifindex = ifindex_;
+  info->ipi_spec_dst.s_addr = src_ip_;
+
+  if (::sendmsg(sock_, &msg, 0) == -1)
+  {
+    return errno;
+  }
+
+  return 0;
+}
+
 }
@@ -37,6 +37,7 @@
 #define RCDISCOVER_SOCKET_LINUX_H
 
 #include "socket.h"
+#include "interface_filter.h"
 
 #include <string>
 
@@ -72,9 +73,13 @@ class SocketLinux : public Socket<SocketLinux>
      * @brief Creates sockets for all interfaces and binds them to the
      * respective interface.
      * @param port destination port
+     * @param mode number of sockets per interface
+     * @param filter selection of interfaces
      * @return vector of sockets
      */
-    static std::vector<SocketLinux> createAndBindForAllInterfaces(uint16_t port);
+    static std::vector<SocketLinux> createAndBindForAllInterfaces(uint16_t port,
+      SocketMode mode=SocketMode::ThreePerInterface,
+      const InterfaceFilter &filter=InterfaceFilter());
 
     /**
      * @brief Constructor.
@@ -120,8 +125,32 @@ class SocketLinux : public Socket<SocketLinux>
     /**
      * @brief Sends data.
      * @param sendbuf data buffer
+     * @param port destination port or 0 for the port of this socket
      */
-    void sendImpl(const std::vector<uint8_t> &sendbuf);
+    void sendImpl(const std::vector<uint8_t> &sendbuf, uint16_t port);
+
+    /**
+     * @brief Sends a batch of packets of equal size.
+     * @param buffer packets stored one after another
+     * @param packet_size size of each packet
+     * @param port destination port or 0 for the port of this socket
+     */
+    void sendBatchImpl(const std::vector<uint8_t> &buffer, size_t packet_size,
+                       uint16_t port);
+
+    /**
+     * @brief Sends data to a unicast address.
+     * @param sendbuf data buffer
+     * @param ip destination IP address in host byte order
+     */
+    void sendToImpl(const std::vector<uint8_t> &sendbuf, uint32_t ip);
+
+    /**
+     * @brief Sends data to the given address.
+     * @param sendbuf data buffer
+     * @param addr destination address
+     */
+    void sendToAddr(const std::vector<uint8_t> &sendbuf, const sockaddr_in &addr);
 
     /**
      * @brief Enables broadcast for this socket.
@@ -143,9 +172,33 @@ class SocketLinux : public Socket<SocketLinux>
      */
     void bindToDevice(const std::string &device);
 
+    /**
+     * @brief Sets the interface and source address that are passed as
+     * IP_PKTINFO control message with every send, so that data leaves via
+     * the given interface. No socket option is set, i.e. IP_PKTINFO is not
+     * enabled for receiving. Additionally to the destination of the socket,
+     * data is sent to the given directed broadcast address.
+     * @param ifindex index of the outgoing interface
+     * @param src_ip source IP address
+     * @param directed_ip directed broadcast address of the interface
+     */
+    void setSendInterface(int ifindex, in_addr_t src_ip, in_addr_t directed_ip);
+
+    /**
+     * @brief Sends data via the interface set with setSendInterface().
+     * @param sendbuf data buffer
+     * @param dst destination address
+     * @return 0 on success, errno otherwise
+     */
+    int sendViaInterface(const std::vector<uint8_t> &sendbuf,
+                         const sockaddr_in &dst);
+
   private:
     int sock_;
     sockaddr_in dst_addr_;
+    int ifindex_;
+    in_addr_t src_ip_;
+    in_addr_t directed_ip_;
 };
 
 }
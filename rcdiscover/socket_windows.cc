@@ -85,8 +85,24 @@ static std::map<int, std::string> getInterfaceNames()
   return result;
 }
 
+std::string SocketWindows::getIfaceNameForAddr(const ULONG ip)
+{
+  DWORD index = 0;
+  if (GetBestInterface(ip, &index) == NO_ERROR)
+  {
+    const auto interface_names = getInterfaceNames();
+    const auto iface = interface_names.find(static_cast<int>(index));
+    if (iface != interface_names.end())
+    {
+      return iface->second;
+    }
+  }
+
+  return std::string();
+}
+
 std::vector<SocketWindows> SocketWindows::createAndBindForAllInterfaces(
-  const uint16_t port)
+  const uint16_t port, SocketMode, const InterfaceFilter &filter)
 {
   std::vector<SocketWindows> sockets;
 
@@ -128,7 +144,7 @@ std::vector<SocketWindows> SocketWindows::createAndBindForAllInterfaces(
           row->dwForwardType == MIB_IPROUTE_TYPE_DIRECT)
       {
         const auto iface = interface_names.find(row->dwForwardIfIndex);
-        if (iface != interface_names.end())
+        if (iface != interface_names.end() && filter.accepts(iface->second))
         {
           sockets.emplace_back(SocketWindows::create(getBroadcastAddr(), port, iface->second));
 
@@ -180,7 +196,7 @@ std::vector<SocketWindows> SocketWindows::createAndBindForAllInterfaces(
       }
 
       const auto iface = interface_names.find(row->dwIndex);
-      if (iface != interface_names.end())
+      if (iface != interface_names.end() && filter.accepts(iface->second))
       {
         const ULONG baddr = row->dwAddr | (~row->dwMask);
 
@@ -256,7 +272,97 @@ void SocketWindows::bindImpl(const sockaddr_in& addr)
   }
 }
 
-void SocketWindows::sendImpl(const std::vector<uint8_t>& sendbuf)
+void SocketWindows::sendImpl(const std::vector<uint8_t>& sendbuf,
+                             const uint16_t port)
+{
+  sockaddr_in addr = dst_addr_;
+  if (port != 0)
+  {
+    addr.sin_port = htons(port);
+  }
+
+  sendToAddr(sendbuf, addr);
+}
+
+void SocketWindows::sendBatchImpl(const std::vector<uint8_t>& buffer,
+                                  const size_t packet_size,
+                                  const uint16_t port)
+{
+  if (packet_size == 0)
+  {
+    return;
+  }
+
+  sockaddr_in addr = dst_addr_;
+  if (port != 0)
+  {
+    addr.sin_port = htons(port);
+  }
+
+  // there is no batch send, but the packets are sent from the buffer
+  // without copying
+
+  size_t i = 0;
+  while (i+packet_size <= buffer.size())
+  {
+    WSABUF wsa_buffer;
+    wsa_buffer.len = static_cast<ULONG>(packet_size);
+    wsa_buffer.buf = const_cast<char *>(
+      reinterpret_cast<const char *>(buffer.data()+i));
+
+    DWORD len;
+    if (::WSASendTo(sock_,
+               &wsa_buffer,
+               1,
+               &len,
+               0,
+               reinterpret_cast<const struct sockaddr *>(&addr),
+               sizeof(addr),
+               nullptr,
+               nullptr) == SOCKET_ERROR)
+    {
+      int err = ::WSAGetLastError();
+
+      if (err == WSAEWOULDBLOCK)
+      {
+        // wait until the send buffer has room again
+
+        WSAPOLLFD pfd;
+        pfd.fd = sock_;
+        pfd.events = POLLWRNORM;
+        pfd.revents = 0;
+
+        if (::WSAPoll(&pfd, 1, 100) <= 0)
+        {
+          throw SocketException("Error while sending data", err);
+        }
+
+        continue;
+      }
+
+      if (err == WSAENETUNREACH || err == WSAEHOSTUNREACH)
+      {
+        throw NetworkUnreachableException(
+              "Error while sending data - network unreachable", err);
+      }
+      throw SocketException("Error while sending data", err);
+    }
+
+    i += packet_size;
+  }
+}
+
+void SocketWindows::sendToImpl(const std::vector<uint8_t>& sendbuf,
+                               const uint32_t ip)
+{
+  sockaddr_in addr = dst_addr_;
+  addr.sin_addr.s_addr = htonl(ip);
+
+  sendToAddr(sendbuf, addr);
+}
+
+void SocketWindows::sendToAddr(const std::vector<uint8_t>& sendbuf,
+                               const sockaddr_in &addr)
 {
   auto sb = sendbuf;
 
@@ -270,8 +376,8 @@ void SocketWindows::sendImpl(const std::vector<uint8_t>& sendbuf)
              1,
              &len,
              0,
-             reinterpret_cast<const struct sockaddr *>(&dst_addr_),
-             sizeof(dst_addr_),
+             reinterpret_cast<const struct sockaddr *>(&addr),
+             sizeof(addr),
              nullptr,
              nullptr) == SOCKET_ERROR)
   {
@@ -37,6 +37,7 @@
 #define RCDISCOVER_SOCKET_WINDOW_H
 
 #include "socket.h"
+#include "interface_filter.h"
 
 #include <winsock2.h>
 
@@ -66,10 +67,13 @@ class SocketWindows : public Socket<SocketWindows>
      * @brief Creates sockets for all interfaces and binds them to the
      * respective interface.
      * @param port destination port
+     * @param mode ignored, since IP_PKTINFO is not used on Windows
+     * @param filter selection of interfaces
      * @return vector of sockets
      */
     static std::vector<SocketWindows> createAndBindForAllInterfaces(
-      uint16_t port);
+      uint16_t port, SocketMode mode=SocketMode::ThreePerInterface,
+      const InterfaceFilter &filter=InterfaceFilter());
 
     /**
      * @brief Constructor.
@@ -92,6 +96,14 @@ class SocketWindows : public Socket<SocketWindows>
      */
     static const ULONG &getBroadcastAddr();
 
+    /**
+     * @brief Returns the name of the interface that is used for reaching the
+     * given address.
+     * @param ip IP address in network byte order
+     * @return interface name or empty string if it cannot be determined
+     */
+    static std::string getIfaceNameForAddr(ULONG ip);
+
   protected:
     /**
      * @brief Returns the native socket handle.
@@ -108,8 +120,32 @@ class SocketWindows : public Socket<SocketWindows>
     /**
      * @brief Sends data.
      * @param sendbuf data buffer
+     * @param port destination port or 0 for the port of this socket
+     */
+    void sendImpl(const std::vector<uint8_t> &sendbuf, uint16_t port);
+
+    /**
+     * @brief Sends a batch of packets of equal size.
+     * @param buffer packets stored one after another
+     * @param packet_size size of each packet
+     * @param port destination port or 0 for the port of this socket
+     */
+    void sendBatchImpl(const std::vector<uint8_t> &buffer, size_t packet_size,
+                       uint16_t port);
+
+    /**
+     * @brief Sends data to a unicast address.
+     * @param sendbuf data buffer
+     * @param ip destination IP address in host byte order
+     */
+    void sendToImpl(const std::vector<uint8_t> &sendbuf, uint32_t ip);
+
+    /**
+     * @brief Sends data to the given address.
+     * @param sendbuf data buffer
+     * @param addr destination address
      */
-    void sendImpl(const std::vector<uint8_t> &sendbuf);
+    void sendToAddr(const std::vector<uint8_t> &sendbuf, const sockaddr_in &addr);
 
     /**
      * @brief Enables broadcast for this socket.
@@ -0,0 +1,282 @@
+/*
+ * rcdiscover - the network discovery tool for Roboception devices
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "stop_policy.h"
+
+#include <algorithm>
+#include <unordered_set>
+#include <unordered_map>
+
+namespace rcdiscover
+{
+
+namespace
+{
+
+/*
+  Counts the distinct MAC addresses of matching devices.
+*/
+
+class ExpectDevices : public StopPolicy::Completion
+{
+  public:
+
+    ExpectDevices(size_t n, std::function<bool(const DeviceInfo &)> match) :
+      n_(n), match_(std::move(match))
+    { }
+
+    void reset() override
+    {
+      mac_.clear();
+    }
+
+    bool add(const DeviceInfo &device, DeviceDeduplicator::Result) override
+    {
+      if (!match_ || match_(device))
+      {
+        mac_.insert(device.getMAC());
+      }
+
+      return mac_.size() >= n_;
+    }
+
+  private:
+
+    size_t n_;
+    std::function<bool(const DeviceInfo &)> match_;
+    std::unordered_set<uint64_t> mac_;
+};
+
+/*
+  Counts the distinct MAC addresses of matching devices and how many of them
+  have answered on all interfaces.
+*/
+
+class ExpectDevicesOnInterfaces : public StopPolicy::Completion
+{
+  public:
+
+    ExpectDevicesOnInterfaces(size_t n, const std::vector<std::string> &ifaces,
+                              std::function<bool(const DeviceInfo &)> match) :
+      n_(n), ifaces_(ifaces.begin(), ifaces.end()), match_(std::move(match)),
+      complete_(0)
+    { }
+
+    void reset() override
+    {
+      answered_.clear();
+      complete_=0;
+    }
+
+    bool add(const DeviceInfo &device, DeviceDeduplicator::Result result) override
+    {
+      if (match_ && !match_(device))
+      {
+        return false;
+      }
+
+      // every interface of a device is only reported once as new
+
+      std::unordered_set<std::string> &answered=answered_[device.getMAC()];
+
+      if (result == DeviceDeduplicator::New &&
+          ifaces_.count(device.getIfaceName()) > 0 &&
+          answered.insert(device.getIfaceName()).second &&
+          answered.size() == ifaces_.size())
+      {
+        complete_++;
+      }
+
+      return answered_.size() >= n_ &&
+        (complete_ == answered_.size() || ifaces_.empty());
+    }
+
+  private:
+
+    size_t n_;
+    std::unordered_set<std::string> ifaces_;
+    std::function<bool(const DeviceInfo &)> match_;
+    std::unordered_map<uint64_t, std::unordered_set<std::string> > answered_;
+    size_t complete_;
+};
+
+}
+
+StopPolicy StopPolicy::fixed(int min_time)
+{
+  return StopPolicy(false, min_time, 0);
+}
+
+StopPolicy StopPolicy::adaptive(int max_time, int quiet)
+{
+  return StopPolicy(true, max_time, quiet);
+}
+
+std::shared_ptr<StopPolicy::Completion> StopPolicy::expectDevices(size_t n,
+  std::function<bool(const DeviceInfo &)> match)
+{
+  return std::make_shared<ExpectDevices>(n, std::move(match));
+}
+
+std::shared_ptr<StopPolicy::Completion> StopPolicy::expectDevicesOnInterfaces(
+  size_t n, const std::vector<std::string> &ifaces,
+  std::function<bool(const DeviceInfo &)> match)
+{
+  return std::make_shared<ExpectDevicesOnInterfaces>(n, ifaces, std::move(match));
+}
+
+StopPolicy::StopPolicy(bool adaptive, int max_time, int quiet) :
+  adaptive_(adaptive),
+  time_(std::max(0, max_time)),
+  quiet_(std::max(0, quiet)),
+  tstart_(std::chrono::steady_clock::now()),
+  last_empty_(false),
+  complete_(false)
+{ }
+
+void StopPolicy::setCompletion(std::shared_ptr<Completion> completion)
+{
+  completion_=std::move(completion);
+}
+
+void StopPolicy::start()
+{
+  tstart_=std::chrono::steady_clock::now();
+  last_empty_=false;
+  iface_.clear();
+  complete_=false;
+  devices_.clear();
+
+  if (completion_)
+  {
+    completion_->reset();
+  }
+}
+
+void StopPolicy::update(const std::vector<DeviceInfo> &info, size_t first)
+{
+  last_empty_=(first >= info.size());
+
+  const std::chrono::steady_clock::time_point now=std::chrono::steady_clock::now();
+
+  for (size_t i=first; i<info.size(); i++)
+  {
+    auto it=iface_.find(info[i].getIfaceName());
+
+    if (it == iface_.end())
+    {
+      // the delay of the first response is the first gap
+
+      IfaceStats stats;
+      stats.last=now;
+      stats.max_gap=now-tstart_;
+      iface_.emplace(info[i].getIfaceName(), stats);
+    }
+    else
+    {
+      it->second.max_gap=std::max(it->second.max_gap, now-it->second.last);
+      it->second.last=now;
+    }
+  }
+
+  // only new and changed responses are passed to the predicate, so that
+  // the cost per response is constant
+
+  for (size_t i=first; i<info.size() && completion_ && !complete_; i++)
+  {
+    if (info[i].isValid())
+    {
+      const DeviceDeduplicator::Result result=devices_.add(info[i]);
+
+      if (result != DeviceDeduplicator::Duplicate)
+      {
+        complete_=completion_->add(info[i], result);
+      }
+    }
+  }
+}
+
+bool StopPolicy::isDone() const
+{
+  const std::chrono::steady_clock::time_point now=std::chrono::steady_clock::now();
+
+  if (complete_)
+  {
+    return true;
+  }
+
+  if (!adaptive_)
+  {
+    return last_empty_ && now-tstart_ >= time_;
+  }
+
+  return now-tstart_ >= time_ || now >= getQuietEnd();
+}
+
+bool StopPolicy::isComplete() const
+{
+  return complete_;
+}
+
+int StopPolicy::getTimeout() const
+{
+  if (!adaptive_)
+  {
+    return 100;
+  }
+
+  const std::chrono::steady_clock::time_point now=std::chrono::steady_clock::now();
+  const std::chrono::steady_clock::time_point tend=std::min(tstart_+time_, getQuietEnd());
+
+  const auto ms=std::chrono::duration_cast<std::chrono::microseconds>(tend-now).count();
+  return static_cast<int>(std::max<long long>(1, (ms+999)/1000));
+}
+
+std::chrono::steady_clock::time_point StopPolicy::getQuietEnd() const
+{
+  // wait quiet time after start for interfaces that did not respond yet
+
+  std::chrono::steady_clock::time_point tend=tstart_+quiet_;
+
+  for (const auto &it : iface_)
+  {
+    const std::chrono::steady_clock::duration wait=std::max<std::chrono::steady_clock::duration>(
+      quiet_, 2*it.second.max_gap);
+
+    tend=std::max(tend, it.second.last+wait);
+  }
+
+  return tend;
+}
+
+}
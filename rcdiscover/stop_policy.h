@@ -0,0 +1,222 @@
+/*
+ * rcdiscover - the network discovery tool for Roboception devices
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef RCDISCOVER_STOP_POLICY_H
+#define RCDISCOVER_STOP_POLICY_H
+
+#include "deviceinfo.h"
+#include "device_deduplicator.h"
+
+#include <vector>
+#include <map>
+#include <memory>
+#include <string>
+#include <chrono>
+#include <functional>
+
+namespace rcdiscover
+{
+
+/**
+ * @brief Decides when collecting discovery responses can be stopped.
+ *
+ * Usage:
+ *
+ * @code
+ * discover.broadcastRequest();
+ * policy.start();
+ * while (!policy.isDone() || discover.hasPendingRequests())
+ * {
+ *   const size_t n=info.size();
+ *   discover.getAllResponses(info, policy.getTimeout());
+ *   policy.update(info, n);
+ * }
+ * @endcode
+ *
+ * A fixed policy waits at least the given time and as long as responses keep
+ * arriving.
+ *
+ * An adaptive policy observes the times between responses per interface. It
+ * stops as soon as no interface has received a response for twice the
+ * longest observed gap (including the delay of the first response after
+ * start()), but for at least the given quiet time. The quiet time is also
+ * waited if there is no response at all. The maximum time is a hard cap.
+ *
+ * Additionally, a completion predicate can be set. It is fed incrementally
+ * with all valid responses, without duplicates of the same device on the same
+ * interface. Collecting is finished immediately if it is satisfied.
+ */
+class StopPolicy
+{
+  public:
+
+    /**
+     * @brief Completion predicate, which keeps its own state, so that every
+     * response is only processed once.
+     */
+    class Completion
+    {
+      public:
+        virtual ~Completion() = default;
+
+        /**
+         * @brief Forgets all responses. Called by StopPolicy::start().
+         */
+        virtual void reset() = 0;
+
+        /**
+         * @brief Registers a response.
+         * @param device response
+         * @param result New for the first response of the device on this
+         *        interface and Changed if its information has changed
+         * @return true if no further responses are required
+         */
+        virtual bool add(const DeviceInfo &device,
+                         DeviceDeduplicator::Result result) = 0;
+    };
+
+    /**
+     * @brief Creates a policy with a fixed minimum time.
+     * @param min_time minimum time in milliseconds
+     * @return policy
+     */
+    static StopPolicy fixed(int min_time=1000);
+
+    /**
+     * @brief Creates an adaptive policy.
+     * @param max_time maximum time in milliseconds
+     * @param quiet minimum time in milliseconds without responses
+     * @return policy
+     */
+    static StopPolicy adaptive(int max_time=1000, int quiet=50);
+
+    /**
+     * @brief Creates a completion predicate that is satisfied if at least
+     * the given number of different devices has been found. Devices are
+     * counted once they match, i.e. a later change does not uncount them.
+     * @param n number of devices
+     * @param match optional function for selecting the devices that are
+     *        counted
+     * @return completion predicate
+     */
+    static std::shared_ptr<Completion> expectDevices(size_t n,
+      std::function<bool(const DeviceInfo &)> match=nullptr);
+
+    /**
+     * @brief Creates a completion predicate that is satisfied if at least
+     * the given number of different devices has been found and every one of
+     * them has answered on all given interfaces. This ensures that all
+     * interfaces through which the devices are reachable are reported.
+     * Devices that are not reachable on all interfaces let collecting run
+     * until the time of the policy is over.
+     * @param n number of devices
+     * @param ifaces names of interfaces, e.g. Discover::getInterfaceNames()
+     * @param match optional function for selecting the devices that are
+     *        counted
+     * @return completion predicate
+     */
+    static std::shared_ptr<Completion> expectDevicesOnInterfaces(size_t n,
+      const std::vector<std::string> &ifaces,
+      std::function<bool(const DeviceInfo &)> match=nullptr);
+
+    /**
+     * @brief Sets the completion predicate.
+     * @param completion predicate or nullptr for removing it
+     */
+    void setCompletion(std::shared_ptr<Completion> completion);
+
+    /**
+     * @brief Starts measuring time. Should be called directly after sending
+     * the request.
+     */
+    void start();
+
+    /**
+     * @brief Registers the responses that have been received since the
+     * last call.
+     * @param info list of all responses
+     * @param first index of the first new response in the list
+     */
+    void update(const std::vector<DeviceInfo> &info, size_t first);
+
+    /**
+     * @brief Checks if collecting responses can be stopped.
+     * @return true if done
+     */
+    bool isDone() const;
+
+    /**
+     * @brief Checks if the completion predicate is satisfied. In contrast to
+     * isDone(), this means that no further responses are required at all.
+     * @return true if the completion predicate is satisfied
+     */
+    bool isComplete() const;
+
+    /**
+     * @brief Returns the time to wait for responses in the next call.
+     * @return timeout in milliseconds
+     */
+    int getTimeout() const;
+
+  private:
+
+    StopPolicy(bool adaptive, int max_time, int quiet);
+
+    /**
+     * @brief Returns the time at which the policy is done if no further
+     * response arrives.
+     */
+    std::chrono::steady_clock::time_point getQuietEnd() const;
+
+    struct IfaceStats
+    {
+      std::chrono::steady_clock::time_point last;
+      std::chrono::steady_clock::duration max_gap;
+    };
+
+    bool adaptive_;
+    std::chrono::milliseconds time_;
+    std::chrono::milliseconds quiet_;
+
+    std::chrono::steady_clock::time_point tstart_;
+    bool last_empty_;
+
+    std::shared_ptr<Completion> completion_;
+    bool complete_;
+    DeviceDeduplicator devices_;
+    std::map<std::string, IfaceStats> iface_;
+};
+
+}
+
+#endif // RCDISCOVER_STOP_POLICY_H
@@ -42,6 +42,7 @@
 #include <stdexcept>
 #include <algorithm>
 #include <array>
+#include <vector>
 
 inline std::string mac2string(const uint64_t mac)
 {
@@ -131,6 +132,64 @@ inline std::array<uint8_t, 4> string2ip(const std::string& ip)
   return string2byte<4>(ip, 10, '.');
 }
 
+/*
+  Parses a comma separated list of IP addresses and address ranges in CIDR
+  notation, e.g. "10.0.0.7,192.168.4.0/22". Network and broadcast addresses
+  of ranges are skipped. Prefixes shorter than 16 bits are rejected for
+  avoiding accidental floods.
+
+  @param s List of addresses.
+  @return  IP addresses in host byte order.
+*/
+
+inline std::vector<uint32_t> string2ipList(const std::string& s)
+{
+  std::vector<uint32_t> result;
+
+  std::istringstream iss(s);
+  std::string item;
+  while (std::getline(iss, item, ','))
+  {
+    int prefix=32;
+
+    const size_t slash=item.find('/');
+    if (slash != std::string::npos)
+    {
+      prefix=std::stoi(item.substr(slash+1));
+      item=item.substr(0, slash);
+
+      if (prefix < 16 || prefix > 32)
+      {
+        throw std::out_of_range("prefix length must be between 16 and 32");
+      }
+    }
+
+    const auto ip=string2byte<4>(item, 10, '.');
+    const uint32_t mask=0xffffffff << (32-prefix);
+    const uint32_t first=((static_cast<uint32_t>(ip[0])<<24) |
+      (static_cast<uint32_t>(ip[1])<<16) | (static_cast<uint32_t>(ip[2])<<8) |
+      static_cast<uint32_t>(ip[3])) & mask;
+    const uint32_t last=first | ~mask;
+
+    if (prefix >= 31)
+    {
+      for (uint64_t a=first; a<=last; a++)
+      {
+        result.push_back(static_cast<uint32_t>(a));
+      }
+    }
+    else
+    {
+      for (uint32_t a=first+1; a<last; a++)
+      {
+        result.push_back(a);
+      }
+    }
+  }
+
+  return result;
+}
+
 template<std::size_t N> struct MinFittingType { };
 template<> struct MinFittingType<1> { using type = std::uint8_t; };
 template<> struct MinFittingType<2> { using type = std::uint16_t; };
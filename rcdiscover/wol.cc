@@ -42,6 +42,7 @@
 #endif
 
 #include "socket_exception.h"
+#include "interface_cache.h"
 
 namespace rcdiscover
 {
@@ -56,6 +57,20 @@ WOL::WOL(std::array<uint8_t, 6> hardware_addr, uint16_t port) noexcept :
   port_{port}
 { }
 
+WOL::WOL(uint64_t hardware_addr, uint16_t port,
+         const InterfaceFilter &filter) :
+  hardware_addr_(toByteArray<6>(std::move(hardware_addr))),
+  port_{port},
+  filter_(filter)
+{ }
+
+WOL::WOL(uint64_t hardware_addr, uint16_t port,
+         std::shared_ptr<InterfaceCache> cache) noexcept :
+  hardware_addr_(toByteArray<6>(std::move(hardware_addr))),
+  port_{port},
+  cache_(std::move(cache))
+{ }
+
 void WOL::send() const
 {
   sendImpl(nullptr);
@@ -66,6 +81,63 @@ void WOL::send(const std::array<uint8_t, 4>& password) const
   sendImpl(&password);
 }
 
+void WOL::sendBatch(
+    const std::vector<std::pair<uint64_t, std::array<uint8_t, 4>>> &targets,
+    uint16_t port, const std::shared_ptr<InterfaceCache> &cache)
+{
+  if (targets.empty())
+  {
+    return;
+  }
+
+  // build all packets into one buffer
+
+  const size_t packet_size = 6 + 16*6 + 4;
+
+  std::vector<uint8_t> sendbuf;
+  sendbuf.reserve(targets.size()*packet_size);
+  for (const auto &target : targets)
+  {
+    WOL(target.first, port).appendMagicPacket(sendbuf, &target.second);
+  }
+
+  if (cache)
+  {
+    cache->update();
+
+    for (auto &socket : cache->getSockets())
+    {
+      try
+      {
+        socket.sendBatch(sendbuf, packet_size, port);
+      }
+      catch(const NetworkUnreachableException &)
+      {
+        continue;
+      }
+    }
+
+    return;
+  }
+
+  auto sockets = SocketType::createAndBindForAllInterfaces(port);
+
+  for (auto &socket : sockets)
+  {
+    socket.enableBroadcast();
+    socket.enableNonBlocking();
+
+    try
+    {
+      socket.sendBatch(sendbuf, packet_size);
+    }
+    catch(const NetworkUnreachableException &)
+    {
+      continue;
+    }
+  }
+}
+
 std::vector<uint8_t>& WOL::appendMagicPacket(
     std::vector<uint8_t>& sendbuf,
     const std::array<uint8_t, 4> *password) const
@@ -105,7 +177,30 @@ std::array<uint8_t, num> WOL::toByteArray(uint64_t data) noexcept
 
 void WOL::sendImpl(const std::array<uint8_t, 4> *password) const
 {
-  auto sockets = SocketType::createAndBindForAllInterfaces(port_);
+  if (cache_)
+  {
+    std::vector<uint8_t> sendbuf;
+    appendMagicPacket(sendbuf, password);
+
+    cache_->update();
+
+    for (auto &socket : cache_->getSockets())
+    {
+      try
+      {
+        socket.send(sendbuf, port_);
+      }
+      catch(const NetworkUnreachableException &)
+      {
+        continue;
+      }
+    }
+
+    return;
+  }
+
+  auto sockets = SocketType::createAndBindForAllInterfaces(
+      port_, SocketMode::ThreePerInterface, filter_);
 
   for (auto &socket : sockets)
   {
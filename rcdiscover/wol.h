@@ -36,9 +36,12 @@
 #ifndef RCDISCOVER_WOL_H
 #define RCDISCOVER_WOL_H
 
+#include "interface_filter.h"
+
 #include <array>
 #include <vector>
 #include <memory>
+#include <utility>
 #include <cstdint>
 
 #ifdef WIN32
@@ -56,6 +59,8 @@ class SocketWindows;
 class SocketLinux;
 #endif
 
+class InterfaceCache;
+
 /**
  * @brief Class for Magic Packet (Wake-on-Lan (WOL)) reset of device.
  */
@@ -82,6 +87,26 @@ class WOL
      * @param port destination UDP port
      */
     WOL(std::array<uint8_t, 6> hardware_addr, uint16_t port) noexcept;
+
+    /**
+     * @brief Constructor.
+     * Sends magic packets only on the selected interfaces.
+     * @param hardware_addr MAC-address of device
+     * @param port destination UDP port
+     * @param filter selection of interfaces
+     */
+    WOL(uint64_t hardware_addr, uint16_t port, const InterfaceFilter &filter);
+
+    /**
+     * @brief Constructor.
+     * Uses the sockets of the given interface cache with the given port
+     * instead of creating new sockets for every packet.
+     * @param hardware_addr MAC-address of device
+     * @param port destination UDP port
+     * @param cache interface cache
+     */
+    WOL(uint64_t hardware_addr, uint16_t port,
+        std::shared_ptr<InterfaceCache> cache) noexcept;
     ~WOL() = default;
 
   public:
@@ -96,6 +121,19 @@ class WOL
      */
     void send(const std::array<uint8_t, 4>& password) const;
 
+    /**
+     * @brief Send Magic Packets with data ("password") to many devices at
+     * once. All packets are built into one contiguous buffer, which is sent
+     * as one batch per socket.
+     * @param targets MAC-addresses of devices and the data to send to them
+     * @param port destination UDP port
+     * @param cache interface cache whose sockets are used or null for
+     * creating sockets for this call
+     */
+    static void sendBatch(
+        const std::vector<std::pair<uint64_t, std::array<uint8_t, 4>>> &targets,
+        uint16_t port, const std::shared_ptr<InterfaceCache> &cache=nullptr);
+
   private:
     /**
      * @brief Appends a magic packet to a data buffer.
@@ -123,6 +161,8 @@ class WOL
   private:
     const std::array<uint8_t, 6> hardware_addr_;
     uint16_t port_;
+    InterfaceFilter filter_;
+    std::shared_ptr<InterfaceCache> cache_;
 };
 
 }
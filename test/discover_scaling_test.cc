@@ -0,0 +1,214 @@
+/*
+ * rcdiscover - the network discovery tool for Roboception devices
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "check.h"
+
+#include "rcdiscover/discover.h"
+#include "rcdiscover/interface_cache.h"
+#include "rcdiscover/descriptor_limit.h"
+
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <poll.h>
+#include <unistd.h>
+
+#include <set>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <vector>
+#include <cstring>
+
+/*
+  Runs a discovery over more than 2000 sockets, which is beyond the
+  FD_SETSIZE limit of select(). All sockets are bound to the loopback
+  interface and send their requests to a local responder, which answers
+  with the port of the requesting socket as MAC address. The test checks
+  that responses are received on all sockets.
+*/
+
+namespace
+{
+
+void respond(int fd, std::atomic_bool &running)
+{
+  while (running)
+  {
+    pollfd pfd;
+    pfd.fd=fd;
+    pfd.events=POLLIN;
+    pfd.revents=0;
+
+    if (::poll(&pfd, 1, 10) <= 0)
+    {
+      continue;
+    }
+
+    uint8_t p[600];
+    sockaddr_in from;
+    socklen_t from_len=sizeof(from);
+
+    while (true)
+    {
+      const ssize_t n=::recvfrom(fd, p, sizeof(p), MSG_DONTWAIT,
+                                 reinterpret_cast<sockaddr *>(&from), &from_len);
+
+      if (n < 0)
+      {
+        break;
+      }
+
+      if (n < 8 || p[0] != 0x42 || p[3] != 0x02)
+      {
+        continue;
+      }
+
+      // DISCOVERY_ACK with the same request id
+
+      uint8_t ack[8+248];
+      memset(ack, 0, sizeof(ack));
+      ack[3]=0x03;
+      ack[4]=0;
+      ack[5]=248;
+      ack[6]=p[6];
+      ack[7]=p[7];
+
+      const uint16_t port=ntohs(from.sin_port);
+      ack[8+14]=static_cast<uint8_t>(port>>8);
+      ack[8+15]=static_cast<uint8_t>(port);
+      ack[8+10]=0x02;
+
+      ::sendto(fd, ack, sizeof(ack), 0, reinterpret_cast<sockaddr *>(&from),
+               from_len);
+    }
+  }
+}
+
+}
+
+int main()
+{
+  const size_t n=2100;
+
+  if (!rcdiscover::raiseDescriptorLimit(n+64))
+  {
+    std::cerr << "Cannot open " << n << " descriptors, skipping" << std::endl;
+    return TEST_SKIP;
+  }
+
+  // responder with a receive buffer for the requests of all sockets
+
+  const int responder=::socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+
+  sockaddr_in addr;
+  memset(&addr, 0, sizeof(addr));
+  addr.sin_family=AF_INET;
+  addr.sin_addr.s_addr=htonl(INADDR_LOOPBACK);
+
+  socklen_t len=sizeof(addr);
+  const int size=4*1024*1024;
+  ::setsockopt(responder, SOL_SOCKET, SO_RCVBUF, &size, sizeof(size));
+
+  if (responder < 0 ||
+      ::bind(responder, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) != 0 ||
+      ::getsockname(responder, reinterpret_cast<sockaddr *>(&addr), &len) != 0)
+  {
+    std::cerr << "Cannot create responder" << std::endl;
+    return 1;
+  }
+
+  // sockets of the discovery, which are all bound to the loopback interface
+
+  std::vector<rcdiscover::InterfaceCache::SocketType> sockets;
+  std::set<uint64_t> expected;
+
+  for (size_t i=0; i<n; i++)
+  {
+    sockets.emplace_back(rcdiscover::InterfaceCache::SocketType::create(
+      htonl(INADDR_LOOPBACK), ntohs(addr.sin_port), "lo"));
+
+    sockaddr_in local;
+    memset(&local, 0, sizeof(local));
+    local.sin_family=AF_INET;
+    local.sin_addr.s_addr=htonl(INADDR_LOOPBACK);
+    sockets.back().bind(local);
+    sockets.back().enableNonBlocking();
+
+    socklen_t local_len=sizeof(local);
+    ::getsockname(sockets.back().getHandle<int>(),
+                  reinterpret_cast<sockaddr *>(&local), &local_len);
+    expected.insert(0x020000000000ULL | ntohs(local.sin_port));
+  }
+
+  CHECK(sockets.back().getHandle<int>() >= FD_SETSIZE);
+
+  std::atomic_bool running(true);
+  std::thread thread(respond, responder, std::ref(running));
+
+  {
+    rcdiscover::Discover discover(std::make_shared<rcdiscover::InterfaceCache>(
+      std::move(sockets)));
+
+    // lost requests and responses are repeated by retransmits
+
+    discover.setRetransmits(5, 50);
+    discover.broadcastRequest();
+
+    std::set<uint64_t> received;
+    std::vector<rcdiscover::DeviceInfo> info;
+
+    const auto end=std::chrono::steady_clock::now()+std::chrono::seconds(5);
+    while (received.size() < expected.size() &&
+           std::chrono::steady_clock::now() < end)
+    {
+      info.clear();
+      discover.getAllResponses(info, 100);
+
+      for (const auto &device : info)
+      {
+        CHECK(device.getIfaceName() == "lo");
+        received.insert(device.getMAC());
+      }
+    }
+
+    CHECK(received == expected);
+  }
+
+  running=false;
+  thread.join();
+  ::close(responder);
+
+  return test_failures;
+}
@@ -0,0 +1,139 @@
+/*
+ * rcdiscover - the network discovery tool for Roboception devices
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "check.h"
+
+#include "rcdiscover/reactor.h"
+#include "rcdiscover/descriptor_limit.h"
+
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+
+#include <vector>
+#include <algorithm>
+#include <cstring>
+
+/*
+  Registers more than 2000 sockets in one reactor, which is beyond the
+  FD_SETSIZE limit of select(), and checks that data on sockets with low and
+  high descriptors is reported.
+*/
+
+int main()
+{
+  const size_t n=2100;
+
+  if (!rcdiscover::raiseDescriptorLimit(n+64))
+  {
+    std::cerr << "Cannot open " << n << " descriptors, skipping" << std::endl;
+    return TEST_SKIP;
+  }
+
+  std::vector<int> fds;
+  std::vector<sockaddr_in> addrs;
+
+  rcdiscover::Reactor reactor;
+
+  for (size_t i=0; i<n; i++)
+  {
+    const int fd=::socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+    if (fd < 0)
+    {
+      std::cerr << "Cannot create socket " << i << std::endl;
+      return 1;
+    }
+
+    sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family=AF_INET;
+    addr.sin_addr.s_addr=htonl(INADDR_LOOPBACK);
+    addr.sin_port=0;
+
+    socklen_t len=sizeof(addr);
+    if (::bind(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) != 0 ||
+        ::getsockname(fd, reinterpret_cast<sockaddr *>(&addr), &len) != 0)
+    {
+      std::cerr << "Cannot bind socket " << i << std::endl;
+      return 1;
+    }
+
+    reactor.add(fd, i);
+    fds.push_back(fd);
+    addrs.push_back(addr);
+  }
+
+  CHECK(fds.back() >= FD_SETSIZE);
+
+  // nothing has been sent yet
+
+  std::vector<size_t> ready;
+  CHECK(reactor.wait(ready, 10) == 0);
+  CHECK(ready.empty());
+
+  // send to the first, a middle and the last socket
+
+  const size_t target[]={0, n/2, n-1};
+  for (size_t i : target)
+  {
+    const char data[]="ping";
+    ::sendto(fds[0], data, sizeof(data), 0,
+             reinterpret_cast<const sockaddr *>(&addrs[i]), sizeof(addrs[i]));
+  }
+
+  std::vector<size_t> received;
+  for (int k=0; k<10 && received.size() < 3; k++)
+  {
+    reactor.wait(ready, 100);
+
+    for (size_t i : ready)
+    {
+      char data[16];
+      while (::recv(fds[i], data, sizeof(data), MSG_DONTWAIT) > 0)
+      {
+        received.push_back(i);
+      }
+    }
+  }
+
+  std::sort(received.begin(), received.end());
+  CHECK(received == std::vector<size_t>(target, target+3));
+
+  for (int fd : fds)
+  {
+    ::close(fd);
+  }
+
+  return test_failures;
+}
@@ -0,0 +1,107 @@
+/*
+ * rcdiscover - the network discovery tool for Roboception devices
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "check.h"
+
+#include "reboot_tracker.h"
+
+int main()
+{
+  // a single dropped response does not count as reboot
+
+  {
+    RebootTracker tracker(3);
+    tracker.add(1);
+    tracker.add(2);
+
+    tracker.answered(1);
+    tracker.answered(2);
+    tracker.endRound();
+
+    tracker.answered(2);
+    tracker.endRound();
+    CHECK(tracker.getState(1) == RebootTracker::Running);
+
+    CHECK(!tracker.answered(1));
+    tracker.answered(2);
+    tracker.endRound();
+    CHECK(tracker.getState(1) == RebootTracker::Running);
+    CHECK(tracker.getOpen() == 2);
+  }
+
+  // missed rounds must be consecutive
+
+  {
+    RebootTracker tracker(3);
+    tracker.add(1);
+
+    for (int i=0; i<5; i++)
+    {
+      tracker.endRound();
+      tracker.endRound();
+      tracker.answered(1);
+      tracker.endRound();
+    }
+
+    CHECK(tracker.getState(1) == RebootTracker::Running);
+  }
+
+  // a device is gone after the given number of missed rounds and returns
+  // with the next answer
+
+  {
+    RebootTracker tracker(3);
+    tracker.add(1);
+    tracker.add(2);
+
+    tracker.endRound();
+    tracker.endRound();
+    CHECK(tracker.getState(1) == RebootTracker::Running);
+    tracker.endRound();
+    CHECK(tracker.getState(1) == RebootTracker::Gone);
+    CHECK(tracker.getState(2) == RebootTracker::Gone);
+
+    CHECK(tracker.answered(1));
+    CHECK(!tracker.answered(1));
+    tracker.endRound();
+    CHECK(tracker.getState(1) == RebootTracker::Returned);
+    CHECK(tracker.getOpen() == 1);
+
+    // answers of other devices are ignored
+
+    CHECK(!tracker.answered(3));
+    CHECK(tracker.getOpen() == 1);
+  }
+
+  return test_failures;
+}
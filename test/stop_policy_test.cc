@@ -0,0 +1,155 @@
+/*
+ * rcdiscover - the network discovery tool for Roboception devices
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "check.h"
+
+#include "rcdiscover/stop_policy.h"
+
+#include <vector>
+
+namespace
+{
+
+rcdiscover::DeviceInfo makeDevice(uint64_t mac, const std::string &iface,
+                                  uint32_t ip=0xc0000200)
+{
+  std::vector<uint8_t> raw(248, 0);
+
+  for (int k=0; k<6; k++)
+  {
+    raw[10+static_cast<size_t>(k)]=static_cast<uint8_t>(mac>>(40-8*k));
+  }
+
+  for (int k=0; k<4; k++)
+  {
+    raw[36+static_cast<size_t>(k)]=static_cast<uint8_t>(ip>>(24-8*k));
+  }
+
+  rcdiscover::DeviceInfo info(iface);
+  info.set(raw.data(), raw.size());
+
+  return info;
+}
+
+/*
+  Feeds the responses one by one and returns the number of responses after
+  which the policy was complete, or 0 if it never was.
+*/
+
+size_t completeAfter(rcdiscover::StopPolicy &policy,
+                     const std::vector<rcdiscover::DeviceInfo> &responses)
+{
+  std::vector<rcdiscover::DeviceInfo> info;
+
+  policy.start();
+  for (size_t i=0; i<responses.size(); i++)
+  {
+    info.push_back(responses[i]);
+    policy.update(info, info.size()-1);
+
+    if (policy.isComplete())
+    {
+      return i+1;
+    }
+  }
+
+  return 0;
+}
+
+}
+
+int main()
+{
+  const std::vector<rcdiscover::DeviceInfo> responses=
+  {
+    makeDevice(1, "eth0"),
+    makeDevice(1, "eth0"),
+    makeDevice(1, "eth1"),
+    makeDevice(2, "eth0"),
+    makeDevice(3, "eth0"),
+    makeDevice(2, "eth1")
+  };
+
+  // distinct devices are counted, regardless of duplicates and interfaces
+
+  {
+    rcdiscover::StopPolicy policy=rcdiscover::StopPolicy::fixed();
+    policy.setCompletion(rcdiscover::StopPolicy::expectDevices(2));
+    CHECK(completeAfter(policy, responses) == 4);
+
+    // start() forgets all devices of the previous run
+
+    CHECK(completeAfter(policy, responses) == 4);
+  }
+
+  {
+    rcdiscover::StopPolicy policy=rcdiscover::StopPolicy::fixed();
+    policy.setCompletion(rcdiscover::StopPolicy::expectDevices(1,
+      [](const rcdiscover::DeviceInfo &info) { return info.getMAC() == 3; }));
+    CHECK(completeAfter(policy, responses) == 5);
+  }
+
+  {
+    rcdiscover::StopPolicy policy=rcdiscover::StopPolicy::fixed();
+    policy.setCompletion(rcdiscover::StopPolicy::expectDevices(4));
+    CHECK(completeAfter(policy, responses) == 0);
+  }
+
+  // devices must have answered on all interfaces
+
+  {
+    rcdiscover::StopPolicy policy=rcdiscover::StopPolicy::fixed();
+    policy.setCompletion(rcdiscover::StopPolicy::expectDevicesOnInterfaces(1,
+      {"eth0", "eth1"}));
+    CHECK(completeAfter(policy, responses) == 3);
+  }
+
+  {
+    // device 2 is found at the 4th response, but has not answered on eth1
+    // before the 6th, while device 3 never answers on eth1
+
+    rcdiscover::StopPolicy policy=rcdiscover::StopPolicy::fixed();
+    policy.setCompletion(rcdiscover::StopPolicy::expectDevicesOnInterfaces(2,
+      {"eth0", "eth1"}, [](const rcdiscover::DeviceInfo &info)
+      {
+        return info.getMAC() != 3;
+      }));
+    CHECK(completeAfter(policy, responses) == 6);
+
+    policy.setCompletion(rcdiscover::StopPolicy::expectDevicesOnInterfaces(2,
+      {"eth0", "eth1"}));
+    CHECK(completeAfter(policy, responses) == 0);
+  }
+
+  return test_failures;
+}
@@ -0,0 +1,456 @@
+/*
+ * rcdiscover - the network discovery tool for Roboception devices
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "rcdiscover/reactor.h"
+#include "rcdiscover/descriptor_limit.h"
+#include "rcdiscover/deviceinfo.h"
+#include "rcdiscover/deviceinfo_view.h"
+
+#ifdef WIN32
+#include <winsock2.h>
+#else
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <unistd.h>
+#endif
+
+#include <iostream>
+#include <iomanip>
+#include <map>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <functional>
+#include <sstream>
+#include <cstring>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+
+// counters of the global operator new for the alloc benchmark
+
+std::size_t alloc_count=0;
+std::size_t alloc_bytes=0;
+
+void *countedAlloc(std::size_t n)
+{
+  alloc_count++;
+  alloc_bytes+=n;
+
+  void *p=std::malloc(n > 0 ? n : 1);
+
+  if (p == 0)
+  {
+    throw std::bad_alloc();
+  }
+
+  return p;
+}
+
+}
+
+// all forms of the global operator new and delete are replaced together, so
+// that memory is always released by the matching function
+
+void *operator new(std::size_t n)
+{
+  return countedAlloc(n);
+}
+
+void *operator new[](std::size_t n)
+{
+  return countedAlloc(n);
+}
+
+void operator delete(void *p) noexcept
+{
+  std::free(p);
+}
+
+void operator delete[](void *p) noexcept
+{
+  std::free(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept
+{
+  std::free(p);
+}
+
+void operator delete[](void *p, std::size_t) noexcept
+{
+  std::free(p);
+}
+
+namespace
+{
+
+typedef std::chrono::steady_clock bench_clock;
+
+double elapsedUs(const bench_clock::time_point &start, int n)
+{
+  return std::chrono::duration<double, std::micro>(bench_clock::now()-start).count()/n;
+}
+
+#ifndef WIN32
+
+/*
+  Measures the time of waiting for and receiving one datagram, depending on
+  the number of sockets that are registered in the reactor.
+*/
+
+int benchWait()
+{
+  const int counts[]={10, 100, 1000, 3000};
+  const int rounds=10000;
+
+  rcdiscover::raiseDescriptorLimit(3000+64);
+
+  std::cout << std::setw(10) << "sockets" << std::setw(16) << "us per wait" << '\n';
+
+  for (int n : counts)
+  {
+    std::vector<int> fds;
+    std::vector<sockaddr_in> addrs;
+    rcdiscover::Reactor reactor;
+
+    for (int i=0; i<n; i++)
+    {
+      const int fd=::socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+      if (fd < 0)
+      {
+        std::cerr << "Cannot create " << n << " sockets" << std::endl;
+        return 1;
+      }
+
+      sockaddr_in addr;
+      memset(&addr, 0, sizeof(addr));
+      addr.sin_family=AF_INET;
+      addr.sin_addr.s_addr=htonl(INADDR_LOOPBACK);
+
+      socklen_t len=sizeof(addr);
+      ::bind(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr));
+      ::getsockname(fd, reinterpret_cast<sockaddr *>(&addr), &len);
+
+      reactor.add(fd, static_cast<size_t>(i));
+      fds.push_back(fd);
+      addrs.push_back(addr);
+    }
+
+    std::vector<size_t> ready;
+    const auto start=bench_clock::now();
+
+    for (int k=0; k<rounds; k++)
+    {
+      const size_t i=static_cast<size_t>(k%n);
+      const char data[]="ping";
+      ::sendto(fds[0], data, sizeof(data), 0,
+               reinterpret_cast<const sockaddr *>(&addrs[i]), sizeof(addrs[i]));
+
+      reactor.wait(ready, 100);
+
+      for (size_t j : ready)
+      {
+        char buffer[16];
+        ::recv(fds[j], buffer, sizeof(buffer), MSG_DONTWAIT);
+      }
+    }
+
+    std::cout << std::setw(10) << n << std::setw(16) << std::fixed <<
+      std::setprecision(2) << elapsedUs(start, rounds) << '\n';
+
+    for (int fd : fds)
+    {
+      ::close(fd);
+    }
+  }
+
+  return 0;
+}
+
+#endif
+
+/*
+  Creates the body of a DISCOVERY_ACK with the given MAC address and typical
+  content of the string fields.
+*/
+
+std::vector<uint8_t> createAckBody(uint64_t mac)
+{
+  std::vector<uint8_t> body(248, 0);
+
+  body[1]=1;
+  body[3]=2;
+
+  for (int i=0; i<6; i++)
+  {
+    body[15-i]=static_cast<uint8_t>(mac>>(8*i));
+  }
+
+  const uint8_t ip[]={192, 168, 1, 10}, mask[]={255, 255, 255, 0}, gw[]={192, 168, 1, 1};
+  memcpy(&body[36], ip, 4);
+  memcpy(&body[52], mask, 4);
+  memcpy(&body[68], gw, 4);
+
+  strcpy(reinterpret_cast<char *>(&body[72]), "Roboception GmbH");
+  strcpy(reinterpret_cast<char *>(&body[104]), "rc_visard 160m");
+  strcpy(reinterpret_cast<char *>(&body[136]), "v22.04.0");
+  strcpy(reinterpret_cast<char *>(&body[168]), "rc_visard_sensor");
+  strcpy(reinterpret_cast<char *>(&body[216]), "02912345");
+  strcpy(reinterpret_cast<char *>(&body[232]), "rc_visard");
+
+  return body;
+}
+
+/*
+  Character wise string extraction as it has been done by DeviceInfo::set()
+  before the introduction of DeviceInfoView. It serves as reference.
+*/
+
+std::string extractLegacy(const uint8_t *p, size_t len)
+{
+  std::ostringstream out;
+
+  while (*p != 0 && len > 0)
+  {
+    out << static_cast<char>(*p);
+
+    p++;
+    len--;
+  }
+
+  return out.str();
+}
+
+struct LegacyDeviceInfo
+{
+  uint64_t mac;
+  std::string strings[6];
+};
+
+void parseLegacy(LegacyDeviceInfo &info, const uint8_t *raw)
+{
+  const size_t offset[]={72, 104, 136, 168, 216, 232}, len[]={32, 32, 32, 48, 16, 16};
+
+  info.mac=0;
+  for (int i=0; i<6; i++) info.mac=(info.mac<<8)|raw[10+i];
+
+  for (int i=0; i<6; i++)
+  {
+    info.strings[i]=extractLegacy(raw+offset[i], len[i]);
+  }
+}
+
+/*
+  Measures the number of DISCOVERY_ACK bodies that can be parsed per second,
+  either completely or only for the MAC address as needed for filtering.
+*/
+
+int benchParse()
+{
+  const int packets=1000000;
+  const int distinct=1000;
+
+  std::vector<std::vector<uint8_t> > bodies;
+  for (int i=0; i<distinct; i++)
+  {
+    bodies.push_back(createAckBody(0x00143d000000ULL+static_cast<uint64_t>(i)));
+  }
+
+  uint64_t sum=0;
+
+  std::cout << std::setw(28) << std::left << "parser" << std::right <<
+    std::setw(18) << "packets per s" << '\n';
+
+  auto report=[](const char *name, const bench_clock::time_point &start)
+  {
+    std::cout << std::setw(28) << std::left << name << std::right <<
+      std::setw(18) << std::fixed << std::setprecision(0) <<
+      1e6/elapsedUs(start, packets) << '\n';
+  };
+
+  {
+    LegacyDeviceInfo info;
+    const auto start=bench_clock::now();
+
+    for (int k=0; k<packets; k++)
+    {
+      parseLegacy(info, bodies[k%distinct].data());
+      sum+=info.mac+info.strings[4].size();
+    }
+
+    report("ostringstream (previous)", start);
+  }
+
+  {
+    rcdiscover::DeviceInfo info("eth0");
+    const auto start=bench_clock::now();
+
+    for (int k=0; k<packets; k++)
+    {
+      const std::vector<uint8_t> &body=bodies[k%distinct];
+      info.set(body.data(), body.size());
+      sum+=info.getMAC()+info.getSerialNumber().size();
+    }
+
+    report("DeviceInfo::set()", start);
+  }
+
+  {
+    const auto start=bench_clock::now();
+
+    for (int k=0; k<packets; k++)
+    {
+      const std::vector<uint8_t> &body=bodies[k%distinct];
+      rcdiscover::DeviceInfo info=rcdiscover::DeviceInfoView(body.data(),
+        body.size()).toDeviceInfo("eth0");
+      sum+=info.getMAC()+info.getSerialNumber().size();
+    }
+
+    report("DeviceInfoView::toDeviceInfo", start);
+  }
+
+  {
+    const auto start=bench_clock::now();
+
+    for (int k=0; k<packets; k++)
+    {
+      const std::vector<uint8_t> &body=bodies[k%distinct];
+      rcdiscover::DeviceInfoView view(body.data(), body.size());
+
+      if (view.isValid())
+      {
+        sum+=view.getMAC();
+      }
+    }
+
+    report("DeviceInfoView MAC only", start);
+  }
+
+  // prevents that the compiler removes the loops
+
+  return sum == 0 ? 1 : 0;
+}
+
+/*
+  Counts the heap allocations per discovered device and the memory that is
+  needed for storing 10,000 devices.
+*/
+
+int benchAlloc()
+{
+  const int devices=10000;
+
+  std::vector<std::vector<uint8_t> > bodies;
+  for (int i=0; i<devices; i++)
+  {
+    bodies.push_back(createAckBody(0x00143d000000ULL+static_cast<uint64_t>(i)));
+  }
+
+  // storing all devices in a result vector
+
+  std::vector<rcdiscover::DeviceInfo> info;
+  info.reserve(devices);
+
+  alloc_count=0;
+  alloc_bytes=0;
+
+  for (const auto &body : bodies)
+  {
+    info.push_back(rcdiscover::DeviceInfoView(body.data(), body.size()).toDeviceInfo("eth0"));
+  }
+
+  const double stored_count=static_cast<double>(alloc_count)/devices;
+  const std::size_t stored_bytes=alloc_bytes;
+
+  // parsing all packets into the same object, as done by getResponse()
+
+  rcdiscover::DeviceInfo reused("eth0");
+  reused.set(bodies[0].data(), bodies[0].size());
+
+  alloc_count=0;
+
+  for (const auto &body : bodies)
+  {
+    reused.set(body.data(), body.size());
+  }
+
+  const double reused_count=static_cast<double>(alloc_count)/devices;
+
+  std::cout << "sizeof(DeviceInfo):              " << sizeof(rcdiscover::DeviceInfo) << " bytes\n";
+  std::cout << "allocations per stored device:   " << stored_count << '\n';
+  std::cout << "allocations per reused set():    " << reused_count << '\n';
+  std::cout << "vector of " << devices << " devices:       " <<
+    sizeof(rcdiscover::DeviceInfo)*devices << " bytes + " << stored_bytes <<
+    " bytes on heap\n";
+
+  return 0;
+}
+
+struct Benchmark
+{
+  std::string description;
+  std::function<int()> fun;
+};
+
+const std::map<std::string, Benchmark> benchmarks=
+{
+#ifndef WIN32
+  {"wait", {"Cost of waiting for a response depending on the number of sockets", benchWait}},
+#endif
+  {"parse", {"Parse throughput of discovery acknowledges", benchParse}},
+  {"alloc", {"Heap allocations and memory of discovered devices", benchAlloc}},
+};
+
+}
+
+int main(int argc, char *argv[])
+{
+  if (argc != 2 || benchmarks.find(argv[1]) == benchmarks.end())
+  {
+    std::cerr << "Usage: " << argv[0] << " <benchmark>\n\n";
+    std::cerr << "Available benchmarks are:\n";
+
+    for (const auto &b : benchmarks)
+    {
+      std::cerr << "    " << std::left << std::setw(10) << b.first << b.second.description << '\n';
+    }
+
+    return 1;
+  }
+
+  return benchmarks.find(argv[1])->second.fun();
+}
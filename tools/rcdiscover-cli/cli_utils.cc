@@ -37,10 +37,16 @@
 
 #include <rcdiscover/utils.h>
 #include <rcdiscover/discover.h>
+#include <rcdiscover/session.h>
+#include <rcdiscover/operation_not_permitted.h>
+#include <rcdiscover/device_deduplicator.h>
 
 #include <stdexcept>
 #include <array>
-#include <chrono>
+#include <algorithm>
+#include <set>
+#include <cctype>
+#include <iostream>
 
 #ifdef WIN32
 #undef min
@@ -84,6 +90,55 @@ int parseFilterArguments(int argc, char **argv, DeviceFilter &filter)
   return 1;
 }
 
+void parseInterfaceArgument(const std::string &option, const std::string &value,
+                            rcdiscover::InterfaceFilter &filter)
+{
+  if (option == "--iface")
+  {
+    filter.include(value);
+  }
+  else if (option == "--iface-exclude")
+  {
+    filter.exclude(value);
+  }
+  else
+  {
+    unsigned int types = 0;
+
+    std::string::size_type start = 0;
+    while (start <= value.size())
+    {
+      std::string::size_type end = value.find(',', start);
+      if (end == std::string::npos)
+      {
+        end = value.size();
+      }
+
+      const std::string type = value.substr(start, end-start);
+      if (type == "bridge")
+      {
+        types |= rcdiscover::InterfaceFilter::Bridge;
+      }
+      else if (type == "veth")
+      {
+        types |= rcdiscover::InterfaceFilter::Veth;
+      }
+      else if (type == "tun")
+      {
+        types |= rcdiscover::InterfaceFilter::Tun;
+      }
+      else
+      {
+        throw std::invalid_argument("Unknown interface type: " + type);
+      }
+
+      start = end+1;
+    }
+
+    filter.skipTypes(types);
+  }
+}
+
 bool filterDevice(const rcdiscover::DeviceInfo &device_info,
                   const DeviceFilter &filter)
 {
@@ -113,30 +168,114 @@ bool filterDevice(const rcdiscover::DeviceInfo &device_info,
   return true;
 }
 
-std::vector<rcdiscover::DeviceInfo> discoverWithFilter(
-    const DeviceFilter &filter)
+std::vector<rcdiscover::DeviceInfo> collectResponses(
+    rcdiscover::Discover &discover, rcdiscover::StopPolicy policy)
 {
-  rcdiscover::Discover discover;
-  discover.broadcastRequest();
+  rcdiscover::DeviceDeduplicator devices;
+  std::vector<rcdiscover::DeviceInfo> infos;
 
-  std::chrono::steady_clock::time_point tstart=std::chrono::steady_clock::now();
-  std::chrono::steady_clock::time_point tend=tstart;
+  // remove multiple entries while the responses arrive
 
-  std::vector<rcdiscover::DeviceInfo> infos;
-  while (discover.getResponse(infos, 100) ||
-    std::chrono::duration<double, std::milli>(tend-tstart).count() < 1000)
+  policy.start();
+  while (!policy.isComplete() &&
+         (!policy.isDone() || discover.hasPendingRequests()))
   {
-    tend=std::chrono::steady_clock::now();
+    infos.clear();
+    discover.getAllResponses(infos, policy.getTimeout());
+    policy.update(infos, 0);
+
+    for (const auto &info : infos)
+    {
+      devices.add(info);
+    }
   }
 
+  // sort by MAC and interface, so that the interfaces of a device are
+  // grouped together
+
+  infos=devices.getDevices();
   std::sort(infos.begin(), infos.end());
-  infos.erase(std::unique(infos.begin(), infos.end(),
-                          [](const rcdiscover::DeviceInfo &lhs,
-                             const rcdiscover::DeviceInfo &rhs)
-                          {
-                            return lhs.getMAC() == rhs.getMAC() &&
-                                   lhs.getIfaceName() == rhs.getIfaceName();
-                          }), infos.end());
+
+  return infos;
+}
+
+int getExactMACCount(const DeviceFilter &filter)
+{
+  std::set<std::string> mac;
+  for (const auto &m : filter.mac)
+  {
+    if (m.find_first_of("*?") != std::string::npos)
+    {
+      return 0;
+    }
+
+    std::string lower(m);
+    std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+    mac.insert(lower);
+  }
+
+  return static_cast<int>(mac.size());
+}
+
+void setExpectedDevices(rcdiscover::StopPolicy &policy,
+                        const DeviceFilter &filter, int expect,
+                        const std::vector<std::string> &ifaces)
+{
+  if (expect <= 0)
+  {
+    expect = getExactMACCount(filter);
+  }
+
+  if (expect <= 0)
+  {
+    return;
+  }
+
+  const auto match = [filter](const rcdiscover::DeviceInfo &info)
+  {
+    return filterDevice(info, filter);
+  };
+
+  if (ifaces.empty())
+  {
+    policy.setCompletion(rcdiscover::StopPolicy::expectDevices(
+      static_cast<size_t>(expect), match));
+    return;
+  }
+
+  // devices cannot answer on interfaces that are excluded by the filter
+
+  std::vector<std::string> selected;
+  for (const auto &iface : ifaces)
+  {
+    if (filter.iface.empty() ||
+        std::any_of(filter.iface.begin(), filter.iface.end(),
+                    [&iface](const std::string &f)
+                    {
+                      return wildcardMatch(iface.begin(), iface.end(),
+                                           f.begin(), f.end());
+                    }))
+    {
+      selected.push_back(iface);
+    }
+  }
+
+  policy.setCompletion(rcdiscover::StopPolicy::expectDevicesOnInterfaces(
+    static_cast<size_t>(expect), selected, match));
+}
+
+std::vector<rcdiscover::DeviceInfo> discoverWithFilter(
+    rcdiscover::Session &session, const DeviceFilter &filter, int expect)
+{
+  rcdiscover::Discover &discover=session.getDiscover();
+  discover.broadcastRequest();
+
+  // devices must have answered on all interfaces, as with the ls command
+
+  rcdiscover::StopPolicy policy=rcdiscover::StopPolicy::fixed();
+  setExpectedDevices(policy, filter, expect, discover.getInterfaceNames());
+
+  const std::vector<rcdiscover::DeviceInfo> infos=collectResponses(discover, policy);
 
   std::vector<rcdiscover::DeviceInfo> filtered_devices;
   for (const auto &info : infos)
@@ -149,6 +288,67 @@ std::vector<rcdiscover::DeviceInfo> discoverWithFilter(
   return filtered_devices;
 }
 
+bool sendForceIPCommands(rcdiscover::Session &session,
+                         const std::vector<rcdiscover::ForceIP::Command> &commands)
+{
+  const auto results=session.getForceIP().sendCommands(commands);
+
+  size_t failed=0;
+  for (size_t i=0; i<commands.size(); i++)
+  {
+    if (!results[i].acknowledged)
+    {
+      std::cout << "No acknowledge from " << mac2string(commands[i].mac)
+                << " after " << results[i].attempts << " attempts" << std::endl;
+      failed++;
+    }
+  }
+
+  if (failed > 0)
+  {
+    std::cout << "Failed for " << failed << " of " << commands.size()
+              << " devices" << std::endl;
+    return false;
+  }
+
+  return true;
+}
+
+bool checkIPConflicts(const std::vector<rcdiscover::ArpProbe::Probe> &probes)
+{
+  std::vector<rcdiscover::ArpProbe::Result> results;
+
+  try
+  {
+    results=rcdiscover::ArpProbe::check(probes);
+  }
+  catch (const rcdiscover::OperationNotPermitted &)
+  {
+    std::cout << "Warning: Checking for IP address conflicts requires root"
+              << " privileges or CAP_NET_RAW, skipped" << std::endl;
+    return true;
+  }
+
+  bool ok=true;
+  for (size_t i=0; i<probes.size(); i++)
+  {
+    if (results[i].conflict)
+    {
+      std::cerr << "IP address " << ip2string(probes[i].ip)
+                << " is already used by " << mac2string(results[i].mac)
+                << std::endl;
+      ok=false;
+    }
+    else if (!results[i].checked)
+    {
+      std::cout << "Warning: Cannot check IP address " << ip2string(probes[i].ip)
+                << " for conflicts, no matching interface" << std::endl;
+    }
+  }
+
+  return ok;
+}
+
 void printTable(std::ostream &oss,
                 const std::vector<std::vector<std::string>> &to_be_printed)
 {
@@ -186,24 +386,52 @@ void printTable(std::ostream &oss,
 void printDeviceTable(std::ostream &oss,
                       const std::vector<rcdiscover::DeviceInfo> &devices,
                       bool print_header,
-                      bool iponly, bool serialonly)
+                      bool iponly, bool serialonly, bool print_round,
+                      const std::vector<std::string> &reachable)
 {
+  const bool print_reachable = !reachable.empty() && !iponly && !serialonly;
+
   std::vector<std::vector<std::string>> to_be_printed;
 
   if (print_header)
   {
     to_be_printed.push_back({"Name", "Serial Number", "IP", "MAC", "Model", "Interface(s)"});
+
+    if (print_round && !iponly && !serialonly)
+    {
+      to_be_printed.back().push_back("Round");
+    }
+
+    if (print_reachable)
+    {
+      to_be_printed.back().push_back("Reachable");
+    }
   }
 
   const rcdiscover::DeviceInfo *last_info = nullptr;
-  for (const auto &info : devices)
+  for (size_t i = 0; i < devices.size(); i++)
   {
+    const auto &info = devices[i];
+
     if (last_info)
     {
       if (info.getMAC() == last_info->getMAC() && !iponly && !serialonly)
       {
-        // append this interface to the existing interface list
-        to_be_printed.back().back() += "," + info.getIfaceName();
+        // append this interface to the existing interface list and report
+        // the earliest round
+        to_be_printed.back()[5] += "," + info.getIfaceName();
+
+        if (print_round && info.getRound() < last_info->getRound())
+        {
+          to_be_printed.back()[6] = std::to_string(info.getRound());
+          last_info = &info;
+        }
+
+        if (print_reachable && to_be_printed.back().back().compare(0, 2, "no") == 0 &&
+            reachable[i].compare(0, 2, "no") != 0)
+        {
+          to_be_printed.back().back() = reachable[i];
+        }
         continue;
       }
     }
@@ -231,6 +459,16 @@ void printDeviceTable(std::ostream &oss,
       print.push_back(mac2string(info.getMAC()));
       print.push_back(info.getModelName());
       print.push_back(info.getIfaceName());
+
+      if (print_round)
+      {
+        print.push_back(std::to_string(info.getRound()));
+      }
+
+      if (print_reachable)
+      {
+        print.push_back(reachable[i]);
+      }
     }
 
     last_info = &info;
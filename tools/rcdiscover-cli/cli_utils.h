@@ -41,6 +41,16 @@
 #include <map>
 
 #include <rcdiscover/deviceinfo.h>
+#include <rcdiscover/stop_policy.h>
+#include <rcdiscover/interface_filter.h>
+#include <rcdiscover/force_ip.h>
+#include <rcdiscover/arp_probe.h>
+
+namespace rcdiscover
+{
+class Discover;
+class Session;
+}
 
 struct DeviceFilter
 {
@@ -53,18 +63,70 @@ struct DeviceFilter
 
 int parseFilterArguments(int argc, char **argv, DeviceFilter &filter);
 
+/**
+ * Applies one of the options --iface, --iface-exclude and --skip-type with
+ * the given value to the interface filter. Throws std::invalid_argument on
+ * unknown interface types.
+ */
+void parseInterfaceArgument(const std::string &option, const std::string &value,
+                            rcdiscover::InterfaceFilter &filter);
+
 bool filterDevice(const rcdiscover::DeviceInfo &device_info,
                   const DeviceFilter &filter);
 
+std::vector<rcdiscover::DeviceInfo> collectResponses(
+    rcdiscover::Discover &discover, rcdiscover::StopPolicy policy);
+
+/**
+ * Returns the number of MAC addresses in the filter if all of them are
+ * given without wildcards and 0 otherwise.
+ */
+int getExactMACCount(const DeviceFilter &filter);
+
+/**
+ * Lets the policy stop as soon as the expected number of devices that match
+ * the filter is found. If expect is 0, then the number of exact MAC addresses
+ * in the filter is used, if any. If interfaces are given, then the devices
+ * must additionally have answered on all of them that match the filter.
+ */
+void setExpectedDevices(rcdiscover::StopPolicy &policy,
+                        const DeviceFilter &filter, int expect,
+                        const std::vector<std::string> &ifaces=
+                          std::vector<std::string>());
+
 std::vector<rcdiscover::DeviceInfo> discoverWithFilter(
-    const DeviceFilter &filter);
+    rcdiscover::Session &session, const DeviceFilter &filter, int expect=0);
+
+/**
+ * Sends FORCEIP commands with acknowledge request to all devices at once and
+ * reports the devices that have not acknowledged. Returns true if all
+ * devices have acknowledged.
+ */
+bool sendForceIPCommands(rcdiscover::Session &session,
+                         const std::vector<rcdiscover::ForceIP::Command> &commands);
+
+/**
+ * Checks with ARP probes if the addresses are already used by other hosts
+ * and prints all conflicts. Returns false if there is any conflict. If the
+ * check is not possible, a warning is printed and true is returned.
+ */
+bool checkIPConflicts(const std::vector<rcdiscover::ArpProbe::Probe> &probes);
 
 void printTable(std::ostream &oss,
                 const std::vector<std::vector<std::string>> &to_be_printed);
 
+/**
+ * Prints the devices as table. Entries of the same device are merged. If
+ * reachable is not empty, it must contain one element per device and is
+ * printed as additional column, in which entries starting with "no" are
+ * replaced by those of other interfaces of the same device.
+ */
 void printDeviceTable(std::ostream &oss,
                       const std::vector<rcdiscover::DeviceInfo> &devices,
-                      bool print_header, bool iponly, bool serialonly);
+                      bool print_header, bool iponly, bool serialonly,
+                      bool print_round=false,
+                      const std::vector<std::string> &reachable=
+                        std::vector<std::string>());
 
 template<typename K, typename V>
 int getMaxCommandLen(const std::map<K, V> &commands)
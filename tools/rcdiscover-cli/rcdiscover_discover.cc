@@ -39,6 +39,8 @@
 
 #include "rcdiscover/discover.h"
 #include "rcdiscover/deviceinfo.h"
+#include "rcdiscover/ping.h"
+#include "rcdiscover/route_table.h"
 #include "rcdiscover/utils.h"
 
 #include <string>
@@ -46,7 +48,6 @@
 #include <iostream>
 #include <iomanip>
 #include <cstring>
-#include <chrono>
 
 static void printHelp(std::ostream &os, const std::string &command)
 {
@@ -60,6 +61,32 @@ static void printHelp(std::ostream &os, const std::string &command)
   os << "-f model=<model>   Filter by model name\n";
   os << "--iponly           Show only the IP addresses of discovered sensors\n";
   os << "--serialonly       Show only the serial number of discovered sensors\n";
+  os << "--single-socket    Use only one socket per interface (Linux only)\n";
+  os << "--iface <pattern>  Use only interfaces that match the pattern, e.g. eth*\n";
+  os << "--iface-exclude <pattern>\n";
+  os << "                   Do not use interfaces that match the pattern\n";
+  os << "--skip-type <types>\n";
+  os << "                   Do not use interfaces of the comma separated types\n";
+  os << "                   bridge, veth and tun\n";
+  os << "--sweep <addrs>    Additionally send unicast requests to a comma\n";
+  os << "                   separated list of addresses or CIDR ranges with\n";
+  os << "                   prefix lengths from /16 to /32, e.g. for devices\n";
+  os << "                   behind routers\n";
+  os << "--sweep-window <n> Maximum number of unanswered unicast requests (default: 256)\n";
+  os << "--sweep-rate <n>   Maximum number of unicast requests per second (default: 5000)\n";
+  os << "--retransmit <n>   Repeat requests n times with exponential backoff for lossy\n";
+  os << "                   links and report the round in which devices answered\n";
+  os << "--adaptive         Stop as soon as no more responses are expected instead\n";
+  os << "                   of waiting at least one second\n";
+  os << "--expect <n>       Stop as soon as n devices that match the filter have\n";
+  os << "                   answered on all interfaces\n";
+  os << "--max-wait <ms>    Maximum time to wait for responses with --adaptive\n";
+  os << "                   (default: 1000)\n";
+  os << "--reachable <mode> Check reachability of the devices with icmp or with tcp\n";
+  os << "                   connects to the web GUI port, or only with the local\n";
+  os << "                   routing table with route\n";
+  os << "--reachable-timeout <ms>\n";
+  os << "                   Time to wait for reachability replies (default: 1000)\n";
 }
 
 int runDiscover(const std::string &command, int argc, char **argv)
@@ -69,7 +96,20 @@ int runDiscover(const std::string &command, int argc, char **argv)
   bool printheader = true;
   bool iponly = false;
   bool serialonly = false;
+  rcdiscover::SocketMode socket_mode = rcdiscover::SocketMode::ThreePerInterface;
+  std::vector<uint32_t> sweep;
+  int sweep_window = 256;
+  int sweep_rate = 5000;
+  bool adaptive = false;
+  int max_wait = 1000;
+  int expect = 0;
+  int retransmit = 0;
+  bool check_reachable = false;
+  bool route_only = false;
+  rcdiscover::ReachabilityMode reachable_mode = rcdiscover::ReachabilityMode::ICMP;
+  int reachable_timeout = 1000;
   DeviceFilter device_filter;
+  rcdiscover::InterfaceFilter iface_filter;
 
   int i = 0;
   while (i < argc)
@@ -86,6 +126,88 @@ int runDiscover(const std::string &command, int argc, char **argv)
       serialonly = true;
       printheader = false;
     }
+    else if (p == "--single-socket")
+    {
+      socket_mode = rcdiscover::SocketMode::OnePerInterface;
+    }
+    else if (p == "--adaptive")
+    {
+      adaptive = true;
+    }
+    else if ((p == "--sweep" || p == "--sweep-window" || p == "--sweep-rate" ||
+              p == "--max-wait" || p == "--expect" ||
+              p == "--retransmit" || p == "--iface" ||
+              p == "--iface-exclude" || p == "--skip-type" ||
+              p == "--reachable" || p == "--reachable-timeout") && i < argc)
+    {
+      try
+      {
+        if (p == "--sweep")
+        {
+          const auto ips = string2ipList(argv[i]);
+          sweep.insert(sweep.end(), ips.begin(), ips.end());
+        }
+        else if (p == "--sweep-window")
+        {
+          sweep_window = std::stoi(argv[i]);
+        }
+        else if (p == "--sweep-rate")
+        {
+          sweep_rate = std::stoi(argv[i]);
+        }
+        else if (p == "--max-wait")
+        {
+          max_wait = std::stoi(argv[i]);
+        }
+        else if (p == "--expect")
+        {
+          expect = std::stoi(argv[i]);
+        }
+        else if (p == "--retransmit")
+        {
+          retransmit = std::stoi(argv[i]);
+        }
+        else if (p == "--reachable")
+        {
+          const std::string mode = argv[i];
+          route_only = false;
+          if (mode == "icmp")
+          {
+            reachable_mode = rcdiscover::ReachabilityMode::ICMP;
+          }
+          else if (mode == "tcp")
+          {
+            reachable_mode = rcdiscover::ReachabilityMode::TCP;
+          }
+          else if (mode == "route")
+          {
+            route_only = true;
+          }
+          else
+          {
+            throw std::invalid_argument(mode);
+          }
+
+          check_reachable = true;
+        }
+        else if (p == "--reachable-timeout")
+        {
+          reachable_timeout = std::stoi(argv[i]);
+        }
+        else
+        {
+          parseInterfaceArgument(p, argv[i], iface_filter);
+        }
+      }
+      catch (const std::exception &)
+      {
+        std::cerr << "Invalid value of " << p << ": " << argv[i] << '\n';
+        printHelp(std::cerr, command);
+        return 1;
+      }
+
+      i++;
+    }
     else if (p == "-f")
     {
       try
@@ -115,31 +237,25 @@ int runDiscover(const std::string &command, int argc, char **argv)
 
   // broadcast discover request
 
-  rcdiscover::Discover discover;
+  rcdiscover::Discover discover(socket_mode, iface_filter);
+  discover.setRetransmits(retransmit);
   discover.broadcastRequest();
 
-  std::vector<rcdiscover::DeviceInfo> infos;
+  if (!sweep.empty())
+  {
+    discover.sweepRequest(sweep, sweep_window, sweep_rate);
+  }
 
-  // get all responses, sort them and remove multiple entries
+  // get all responses, sorted and without multiple entries
 
-  std::chrono::steady_clock::time_point tstart=std::chrono::steady_clock::now();
-  std::chrono::steady_clock::time_point tend=tstart;
+  rcdiscover::StopPolicy policy=adaptive ?
+    rcdiscover::StopPolicy::adaptive(max_wait) : rcdiscover::StopPolicy::fixed();
+  // all interfaces of the devices are listed, so that they must have answered
+  // on all of them
 
-  while (discover.getResponse(infos, 100) ||
-    std::chrono::duration<double, std::milli>(tend-tstart).count() < 1000)
-  {
-    tend=std::chrono::steady_clock::now();
-  }
+  setExpectedDevices(policy, device_filter, expect, discover.getInterfaceNames());
 
-  std::sort(infos.begin(), infos.end());
-  const auto it = std::unique(infos.begin(), infos.end(),
-                              [](const rcdiscover::DeviceInfo &lhs,
-                                 const rcdiscover::DeviceInfo &rhs)
-                              {
-                                return lhs.getMAC() == rhs.getMAC() &&
-                                       lhs.getIfaceName() == rhs.getIfaceName();
-                              });
-  infos.erase(it, infos.end());
+  std::vector<rcdiscover::DeviceInfo> infos=collectResponses(discover, policy);
 
   // go through all valid entries
 
@@ -157,7 +273,72 @@ int runDiscover(const std::string &command, int argc, char **argv)
     filtered_infos.push_back(info);
   }
 
-  printDeviceTable(std::cout, filtered_infos, printheader, iponly, serialonly);
+  // check reachability of all devices at once, devices that cannot be
+  // reached according to the routing table are not probed
+
+  std::vector<std::string> reachable;
+  if (check_reachable)
+  {
+    std::vector<uint32_t> ip;
+    std::vector<size_t> probed;
+
+    try
+    {
+      const rcdiscover::RouteTable routes = rcdiscover::RouteTable::load();
+
+      for (size_t k = 0; k < filtered_infos.size(); k++)
+      {
+        const rcdiscover::RouteTable::Classification c =
+          routes.classify(filtered_infos[k]);
+
+        std::string s;
+        if (c.type == rcdiscover::RouteTable::Type::Unroutable)
+        {
+          s = std::string("no (") + c.reason + ")";
+        }
+        else if (route_only)
+        {
+          s = c.type == rcdiscover::RouteTable::Type::OnLink ? "on link" :
+            "via " + ip2string(c.gateway);
+        }
+        else
+        {
+          ip.push_back(filtered_infos[k].getIP());
+          probed.push_back(k);
+        }
+
+        reachable.push_back(s);
+      }
+    }
+    catch (const std::exception &ex)
+    {
+      std::cerr << "Cannot read routing table: " << ex.what() << std::endl;
+
+      reachable.assign(filtered_infos.size(), route_only ? "unknown" : "");
+      ip.clear();
+      probed.clear();
+
+      for (size_t k = 0; k < filtered_infos.size() && !route_only; k++)
+      {
+        ip.push_back(filtered_infos[k].getIP());
+        probed.push_back(k);
+      }
+    }
+
+    if (!ip.empty())
+    {
+      const std::vector<bool> r = rcdiscover::checkReachability(ip,
+        reachable_mode, reachable_timeout);
+
+      for (size_t k = 0; k < probed.size(); k++)
+      {
+        reachable[probed[k]] = r[k] ? "yes" : "no";
+      }
+    }
+  }
+
+  printDeviceTable(std::cout, filtered_infos, printheader, iponly, serialonly,
+                   retransmit > 0, reachable);
 
   return 0;
 }
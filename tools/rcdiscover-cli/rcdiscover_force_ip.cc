@@ -39,14 +39,24 @@
 
 #include <rcdiscover/utils.h>
 #include <rcdiscover/force_ip.h>
+#include <rcdiscover/session.h>
+
+#include <rcdiscover/discover.h>
 
 #include <stdexcept>
 #include <iostream>
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <map>
+#include <set>
+#include <cctype>
 
 static void printHelp(std::ostream &os, const std::string &command)
 {
   os << "Usage: ";
   os << command << " [<args>] <IP address> <subnet mask> <default gateway>\n";
+  os << "       " << command << " [<args>] --plan <file>\n";
   os << '\n';
   os << "-h, --help         Show this help and exit\n";
   os << "-f name=<name>     Filter by name\n";
@@ -55,12 +65,409 @@ static void printHelp(std::ostream &os, const std::string &command)
   os << "-f iface=<mac>     Filter by interface name\n";
   os << "-f model=<model>   Filter by model name\n";
   os << "-y                 Assume 'yes' for all queries\n";
+  os << "--expect <n>       Stop discovery as soon as n matching devices are found.\n";
+  os << "                   Implicit for MAC address filters without wildcards\n";
+  os << "--iface <pattern>  Use only interfaces that match the pattern, e.g. eth*\n";
+  os << "--iface-exclude <pattern>\n";
+  os << "                   Do not use interfaces that match the pattern\n";
+  os << "--skip-type <types>\n";
+  os << "                   Do not use interfaces of the comma separated types\n";
+  os << "                   bridge, veth and tun\n";
+  os << "--no-conflict-check\n";
+  os << "                   Do not check with ARP probes if the IP addresses are\n";
+  os << "                   already in use\n";
+  os << "--plan <file>      Set the IP addresses of many devices at once. Each line\n";
+  os << "                   of the file contains <MAC or serial number>,<IP address>,\n";
+  os << "                   <subnet mask>,<default gateway>. Empty lines and lines\n";
+  os << "                   starting with # are ignored\n";
+}
+
+namespace
+{
+
+struct PlanEntry
+{
+  int line;
+  std::string key;
+  bool by_mac;
+  uint64_t mac;
+  uint32_t ip;
+  uint32_t mask;
+  uint32_t gateway;
+};
+
+}
+
+/*
+  Reads the plan file. Errors are printed with the line number. Returns false
+  in case of errors.
+*/
+
+static bool readPlan(const std::string &name, std::vector<PlanEntry> &plan)
+{
+  std::ifstream in(name);
+  if (!in)
+  {
+    std::cerr << "Cannot open plan file: " << name << std::endl;
+    return false;
+  }
+
+  bool ok=true;
+  int line=0;
+  std::string row;
+  while (std::getline(in, row))
+  {
+    line++;
+
+    row.erase(std::remove_if(row.begin(), row.end(),
+      [](char c) { return std::isspace(static_cast<unsigned char>(c)) != 0; }),
+      row.end());
+
+    if (row.empty() || row[0] == '#')
+    {
+      continue;
+    }
+
+    try
+    {
+      const auto field=split<4>(row, ',');
+
+      PlanEntry entry;
+      entry.line=line;
+      entry.key=field[0];
+      entry.by_mac=false;
+      entry.mac=0;
+
+      if (entry.key.find(':') != std::string::npos)
+      {
+        entry.by_mac=true;
+        entry.mac=byteArrayToInt(string2mac(entry.key));
+      }
+
+      entry.ip=byteArrayToInt(string2ip(field[1]));
+      entry.mask=byteArrayToInt(string2ip(field[2]));
+      entry.gateway=byteArrayToInt(string2ip(field[3]));
+
+      plan.push_back(entry);
+    }
+    catch (const std::exception &)
+    {
+      std::cerr << name << ":" << line << ": Cannot parse line: " << row << std::endl;
+      ok=false;
+    }
+  }
+
+  return ok;
+}
+
+/*
+  Checks the plan for errors, which prevent assigning the addresses, and
+  prints warnings. Returns false in case of errors.
+*/
+
+static bool validatePlan(const std::vector<PlanEntry> &plan)
+{
+  bool ok=true;
+
+  std::map<std::string, int> keys;
+  std::map<uint32_t, int> ips;
+
+  for (const auto &entry : plan)
+  {
+    std::string key=entry.key;
+    if (entry.by_mac)
+    {
+      key=mac2string(entry.mac);
+    }
+
+    const auto k=keys.insert(std::make_pair(key, entry.line));
+    if (!k.second)
+    {
+      std::cerr << "Line " << entry.line << ": Device " << entry.key
+                << " is already planned in line " << k.first->second << std::endl;
+      ok=false;
+    }
+
+    const auto a=ips.insert(std::make_pair(entry.ip, entry.line));
+    if (!a.second)
+    {
+      std::cerr << "Line " << entry.line << ": IP address " << ip2string(entry.ip)
+                << " is already planned in line " << a.first->second << std::endl;
+      ok=false;
+    }
+
+    // the subnet mask must consist of leading ones
+
+    if (entry.mask == 0 || (~entry.mask & (~entry.mask+1)) != 0)
+    {
+      std::cerr << "Line " << entry.line << ": Invalid subnet mask "
+                << ip2string(entry.mask) << std::endl;
+      ok=false;
+      continue;
+    }
+
+    const uint32_t host=entry.ip & ~entry.mask;
+    if (entry.ip == 0 || (entry.mask < 0xfffffffe && (host == 0 || host == ~entry.mask)))
+    {
+      std::cerr << "Line " << entry.line << ": " << ip2string(entry.ip)
+                << " is not a valid host address in its subnet" << std::endl;
+      ok=false;
+    }
+
+    if (entry.gateway != 0 && (entry.ip & entry.mask) != (entry.gateway & entry.mask))
+    {
+      std::cout << "Warning: Line " << entry.line << ": IP address and gateway"
+                << " appear to be in different subnets" << std::endl;
+    }
+  }
+
+  return ok;
+}
+
+/*
+  Assigns the IP addresses of a plan file with one discovery, concurrent
+  FORCEIP commands and one discovery for verification.
+*/
+
+static int runPlan(const std::string &name, bool yes, bool conflict_check,
+                   const rcdiscover::InterfaceFilter &iface_filter)
+{
+  std::vector<PlanEntry> plan;
+  const bool read=readPlan(name, plan);
+  if (!validatePlan(plan) || !read)
+  {
+    return 1;
+  }
+
+  if (plan.empty())
+  {
+    std::cout << "Plan is empty" << std::endl;
+    return 0;
+  }
+
+  // discover all devices of the plan at once
+
+  std::set<uint64_t> plan_mac;
+  std::set<std::string> plan_serial;
+  for (const auto &entry : plan)
+  {
+    if (entry.by_mac)
+    {
+      plan_mac.insert(entry.mac);
+    }
+    else
+    {
+      plan_serial.insert(entry.key);
+    }
+  }
+
+  rcdiscover::Session session(iface_filter);
+  rcdiscover::Discover &discover=session.getDiscover();
+
+  rcdiscover::StopPolicy policy=rcdiscover::StopPolicy::fixed();
+  policy.setCompletion(rcdiscover::StopPolicy::expectDevices(plan.size(),
+    [&plan_mac, &plan_serial](const rcdiscover::DeviceInfo &info)
+    {
+      return plan_mac.count(info.getMAC()) > 0 ||
+             plan_serial.count(info.getSerialNumber()) > 0;
+    }));
+
+  discover.broadcastRequest();
+  const std::vector<rcdiscover::DeviceInfo> devices=collectResponses(discover, policy);
+
+  // find the device of every entry and check for conflicts with other
+  // devices
+
+  bool ok=true;
+  std::vector<const rcdiscover::DeviceInfo *> planned(plan.size(), nullptr);
+  std::map<uint64_t, size_t> planned_mac;
+
+  for (size_t i=0; i<plan.size(); i++)
+  {
+    for (const auto &device : devices)
+    {
+      if (device.isValid() && (plan[i].by_mac ? device.getMAC() == plan[i].mac :
+                               device.getSerialNumber() == plan[i].key))
+      {
+        planned[i]=&device;
+        break;
+      }
+    }
+
+    if (!planned[i])
+    {
+      std::cerr << "Line " << plan[i].line << ": Device " << plan[i].key
+                << " not found" << std::endl;
+      ok=false;
+      continue;
+    }
+
+    const auto m=planned_mac.insert(std::make_pair(planned[i]->getMAC(), i));
+    if (!m.second)
+    {
+      std::cerr << "Line " << plan[i].line << ": Device " << plan[i].key
+                << " is already planned in line " << plan[m.first->second].line
+                << std::endl;
+      ok=false;
+    }
+  }
+
+  for (size_t i=0; i<plan.size(); i++)
+  {
+    for (const auto &device : devices)
+    {
+      if (device.isValid() && device.getIP() == plan[i].ip &&
+          planned_mac.count(device.getMAC()) == 0)
+      {
+        std::cerr << "Line " << plan[i].line << ": IP address "
+                  << ip2string(plan[i].ip) << " is used by device "
+                  << mac2string(device.getMAC()) << ", which is not in the plan"
+                  << std::endl;
+        ok=false;
+        break;
+      }
+    }
+  }
+
+  // check all planned addresses for hosts that are not discoverable, except
+  // the current addresses of planned devices, which are released by the plan
+  // itself, e.g. if devices swap their addresses
+
+  if (ok && conflict_check)
+  {
+    std::set<uint32_t> planned_ip;
+    for (const auto *device : planned)
+    {
+      planned_ip.insert(device->getIP());
+    }
+
+    std::vector<rcdiscover::ArpProbe::Probe> probes;
+    for (size_t i=0; i<plan.size(); i++)
+    {
+      if (planned_ip.count(plan[i].ip) == 0)
+      {
+        probes.push_back({plan[i].ip, planned[i]->getIfaceName(),
+                          planned[i]->getMAC()});
+      }
+    }
+
+    if (!probes.empty())
+    {
+      ok=checkIPConflicts(probes);
+    }
+  }
+
+  if (!ok)
+  {
+    return 1;
+  }
+
+  std::vector<std::vector<std::string>> to_be_printed;
+  to_be_printed.push_back({"Name", "Serial Number", "MAC", "IP", "New IP",
+                           "Subnet Mask", "Gateway"});
+
+  std::vector<rcdiscover::ForceIP::Command> commands;
+  for (size_t i=0; i<plan.size(); i++)
+  {
+    const rcdiscover::DeviceInfo &device=*planned[i];
+
+    to_be_printed.push_back({device.getUserName().empty() ?
+                             device.getModelName() : device.getUserName(),
+                             device.getSerialNumber(), mac2string(device.getMAC()),
+                             ip2string(device.getIP()), ip2string(plan[i].ip),
+                             ip2string(plan[i].mask), ip2string(plan[i].gateway)});
+
+    commands.push_back({device.getMAC(), plan[i].ip, plan[i].mask, plan[i].gateway});
+  }
+
+  std::cout << "Setting the IP addresses of the following devices:\n";
+  printTable(std::cout, to_be_printed);
+
+  if (!yes)
+  {
+    std::cout << "Are you sure? [y/N] ";
+    std::string answer;
+    std::getline(std::cin, answer);
+    if (answer != "y" && answer != "Y")
+    {
+      std::cout << "Cancel" << std::endl;
+      return 0;
+    }
+  }
+
+  if (!sendForceIPCommands(session, commands))
+  {
+    return 1;
+  }
+
+  // verify all new addresses with one discovery
+
+  policy=rcdiscover::StopPolicy::fixed();
+  policy.setCompletion(rcdiscover::StopPolicy::expectDevices(commands.size(),
+    [&commands](const rcdiscover::DeviceInfo &info)
+    {
+      return std::any_of(commands.begin(), commands.end(),
+        [&info](const rcdiscover::ForceIP::Command &command)
+        {
+          return command.mac == info.getMAC() && command.ip == info.getIP();
+        });
+    }));
+
+  discover.broadcastRequest();
+  const std::vector<rcdiscover::DeviceInfo> verify=collectResponses(discover, policy);
+
+  size_t failed=0;
+  for (const auto &command : commands)
+  {
+    const rcdiscover::DeviceInfo *found=nullptr;
+    for (const auto &device : verify)
+    {
+      if (device.isValid() && device.getMAC() == command.mac)
+      {
+        found=&device;
+
+        if (device.getIP() == command.ip)
+        {
+          break;
+        }
+      }
+    }
+
+    if (!found)
+    {
+      std::cout << mac2string(command.mac) << ": Not found after setting the IP address"
+                << std::endl;
+      failed++;
+    }
+    else if (found->getIP() != command.ip)
+    {
+      std::cout << mac2string(command.mac) << ": IP address is "
+                << ip2string(found->getIP()) << " instead of "
+                << ip2string(command.ip) << std::endl;
+      failed++;
+    }
+  }
+
+  if (failed > 0)
+  {
+    std::cout << "Verification failed for " << failed << " of "
+              << commands.size() << " devices" << std::endl;
+    return 1;
+  }
+
+  std::cout << "Done, all " << commands.size() << " devices verified" << std::endl;
+
+  return 0;
 }
 
 int runForceIP(const std::string &command, int argc, char **argv)
 {
   DeviceFilter device_filter{};
   bool yes = false;
+  int expect = 0;
+  std::string plan;
+  bool conflict_check = true;
+  rcdiscover::InterfaceFilter iface_filter;
 
   int i = 0;
   while (i < argc)
@@ -71,6 +478,41 @@ int runForceIP(const std::string &command, int argc, char **argv)
     {
       yes = true;
     }
+    else if (p == "--expect" && i < argc)
+    {
+      try
+      {
+        expect = std::stoi(argv[i++]);
+      }
+      catch (const std::exception &)
+      {
+        std::cerr << "Invalid value of --expect: " << argv[i-1] << '\n';
+        printHelp(std::cerr, command);
+        return 1;
+      }
+    }
+    else if (p == "--no-conflict-check")
+    {
+      conflict_check = false;
+    }
+    else if (p == "--plan" && i < argc)
+    {
+      plan = argv[i++];
+    }
+    else if ((p == "--iface" || p == "--iface-exclude" ||
+              p == "--skip-type") && i < argc)
+    {
+      try
+      {
+        parseInterfaceArgument(p, argv[i++], iface_filter);
+      }
+      catch (const std::invalid_argument &ex)
+      {
+        std::cerr << ex.what() << std::endl;
+        printHelp(std::cerr, command);
+        return 1;
+      }
+    }
     else if (p == "-f")
     {
       try
@@ -102,6 +544,19 @@ int runForceIP(const std::string &command, int argc, char **argv)
     }
   }
 
+  if (!plan.empty())
+  {
+    if (i != argc)
+    {
+      std::cerr << "IP address, subnet mask and default gateway must not be set with --plan"
+                << std::endl;
+      printHelp(std::cerr, command);
+      return 1;
+    }
+
+    return runPlan(plan, yes, conflict_check, iface_filter);
+  }
+
   if (device_filter.mac.empty() &&
       device_filter.name.empty() &&
       device_filter.serial.empty())
@@ -155,7 +610,10 @@ int runForceIP(const std::string &command, int argc, char **argv)
     return 1;
   }
 
-  const auto devices = discoverWithFilter(device_filter);
+  // sockets are shared by discovery and all following commands
+
+  rcdiscover::Session session(iface_filter);
+  const auto devices = discoverWithFilter(session, device_filter, expect);
 
   if (devices.empty())
   {
@@ -170,6 +628,13 @@ int runForceIP(const std::string &command, int argc, char **argv)
     return 0;
   }
 
+  if (conflict_check &&
+      !checkIPConflicts({{byteArrayToInt(ip), devices[0].getIfaceName(),
+                          devices[0].getMAC()}}))
+  {
+    return 1;
+  }
+
   std::cout << "Setting the IP address of the following device:\n";
   printDeviceTable(std::cout, devices, true, false, false);
 
@@ -185,13 +650,16 @@ int runForceIP(const std::string &command, int argc, char **argv)
     }
   }
 
+  std::vector<rcdiscover::ForceIP::Command> commands;
   for (const auto &device : devices)
   {
-    rcdiscover::ForceIP force_ip;
-    force_ip.sendCommand(device.getMAC(),
-                         byteArrayToInt(ip),
-                         byteArrayToInt(mask),
-                         byteArrayToInt(gateway));
+    commands.push_back({device.getMAC(), byteArrayToInt(ip),
+                        byteArrayToInt(mask), byteArrayToInt(gateway)});
+  }
+
+  if (!sendForceIPCommands(session, commands))
+  {
+    return 1;
   }
 
   std::cout << "Done" << std::endl;
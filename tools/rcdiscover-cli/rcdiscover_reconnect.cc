@@ -39,6 +39,7 @@
 
 #include <rcdiscover/discover.h>
 #include <rcdiscover/force_ip.h>
+#include <rcdiscover/session.h>
 
 #include <stdexcept>
 #include <iostream>
@@ -56,12 +57,22 @@ static void printHelp(std::ostream &os, const std::string &command)
   os << "-f iface=<mac>     Filter by interface name\n";
   os << "-f model=<model>   Filter by model name\n";
   os << "-y                 Assume 'yes' for all queries\n";
+  os << "--expect <n>       Stop discovery as soon as n matching devices are found.\n";
+  os << "                   Implicit for MAC address filters without wildcards\n";
+  os << "--iface <pattern>  Use only interfaces that match the pattern, e.g. eth*\n";
+  os << "--iface-exclude <pattern>\n";
+  os << "                   Do not use interfaces that match the pattern\n";
+  os << "--skip-type <types>\n";
+  os << "                   Do not use interfaces of the comma separated types\n";
+  os << "                   bridge, veth and tun\n";
 }
 
 int runReconnect(const std::string &command, int argc, char **argv)
 {
   DeviceFilter device_filter{};
   bool yes = false;
+  int expect = 0;
+  rcdiscover::InterfaceFilter iface_filter;
 
   int i=0;
   while (i < argc)
@@ -72,6 +83,33 @@ int runReconnect(const std::string &command, int argc, char **argv)
     {
       yes = true;
     }
+    else if (p == "--expect" && i < argc)
+    {
+      try
+      {
+        expect = std::stoi(argv[i++]);
+      }
+      catch (const std::exception &)
+      {
+        std::cerr << "Invalid value of --expect: " << argv[i-1] << '\n';
+        printHelp(std::cerr, command);
+        return 1;
+      }
+    }
+    else if ((p == "--iface" || p == "--iface-exclude" ||
+              p == "--skip-type") && i < argc)
+    {
+      try
+      {
+        parseInterfaceArgument(p, argv[i++], iface_filter);
+      }
+      catch (const std::invalid_argument &ex)
+      {
+        std::cerr << ex.what() << std::endl;
+        printHelp(std::cerr, command);
+        return 1;
+      }
+    }
     else if (p == "-f")
     {
       try
@@ -107,7 +145,10 @@ int runReconnect(const std::string &command, int argc, char **argv)
     return 1;
   }
 
-  const auto devices = discoverWithFilter(device_filter);
+  // sockets are shared by discovery and all following commands
+
+  rcdiscover::Session session(iface_filter);
+  const auto devices = discoverWithFilter(session, device_filter, expect);
 
   if (devices.empty())
   {
@@ -130,10 +171,21 @@ int runReconnect(const std::string &command, int argc, char **argv)
     }
   }
 
+  // reconnect all devices at once, but only once even if a device has been
+  // found on several interfaces
+
+  std::vector<rcdiscover::ForceIP::Command> commands;
   for (const auto &device : devices)
   {
-    rcdiscover::ForceIP force_ip;
-    force_ip.sendCommand(device.getMAC(), 0, 0, 0);
+    if (commands.empty() || commands.back().mac != device.getMAC())
+    {
+      commands.push_back({device.getMAC(), 0, 0, 0});
+    }
+  }
+
+  if (!sendForceIPCommands(session, commands))
+  {
+    return 1;
   }
 
   std::cout << "Done" << std::endl;
@@ -36,14 +36,20 @@
 #include "rcdiscover_reset.h"
 
 #include "cli_utils.h"
+#include "reboot_tracker.h"
 
 #include <rcdiscover/discover.h>
 #include <rcdiscover/wol.h>
+#include <rcdiscover/session.h>
+#include <rcdiscover/utils.h>
 
 #include <stdexcept>
 #include <iostream>
 #include <algorithm>
 #include <map>
+#include <chrono>
+#include <sstream>
+#include <iomanip>
 
 struct ResetCommand
 {
@@ -85,12 +91,139 @@ static void printHelp(std::ostream &os, const std::string &command)
   os << "    -f iface=<mac>     Filter by interface name\n";
   os << "    -f model=<model>   Filter by model name\n";
   os << "    -y                 Assume 'yes' for all queries\n";
+  os << "    --expect <n>       Stop discovery as soon as n matching devices are found.\n";
+  os << "                       Implicit for MAC address filters without wildcards\n";
+  os << "    --iface <pattern>  Use only interfaces that match the pattern, e.g. eth*\n";
+  os << "    --iface-exclude <pattern>\n";
+  os << "                       Do not use interfaces that match the pattern\n";
+  os << "    --skip-type <types>\n";
+  os << "                       Do not use interfaces of the comma separated types\n";
+  os << "                       bridge, veth and tun\n";
+  os << "    --confirm          Wait until all devices have rebooted and report the time\n";
+  os << "                       until each device was reachable again\n";
+  os << "    --timeout <s>      Maximum time to wait with --confirm (default: 180)\n";
+}
+
+namespace
+{
+
+struct ResetState
+{
+  explicit ResetState(const rcdiscover::DeviceInfo &_info) :
+    info(_info), seconds(0)
+  { }
+
+  rcdiscover::DeviceInfo info;
+  double seconds;
+};
+
+}
+
+/*
+  Watches all reset devices with one discovery loop of one second per round.
+  A device counts as gone if it does not answer in three consecutive rounds
+  and as returned as soon as it answers again afterwards. Returns true if all
+  devices have returned.
+*/
+
+static bool waitForReturn(rcdiscover::Session &session,
+                          const std::vector<rcdiscover::DeviceInfo> &devices,
+                          int timeout)
+{
+  typedef std::chrono::steady_clock clock;
+
+  std::map<uint64_t, ResetState> states;
+  RebootTracker tracker;
+  for (const auto &device : devices)
+  {
+    states.insert(std::make_pair(device.getMAC(), ResetState(device)));
+    tracker.add(device.getMAC());
+  }
+
+  rcdiscover::Discover &discover=session.getDiscover();
+
+  const auto start=clock::now();
+  const auto deadline=start+std::chrono::seconds(timeout);
+
+  std::vector<rcdiscover::DeviceInfo> infos;
+  while (tracker.getOpen() > 0 && clock::now() < deadline)
+  {
+    discover.broadcastRequest();
+
+    const auto round_end=std::min(clock::now()+std::chrono::seconds(1), deadline);
+    auto now=clock::now();
+    while (now < round_end)
+    {
+      infos.clear();
+      discover.getAllResponses(infos, static_cast<int>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(round_end-now).count())+1);
+      now=clock::now();
+
+      for (const auto &info : infos)
+      {
+        if (!info.isValid())
+        {
+          continue;
+        }
+
+        if (tracker.answered(info.getMAC()))
+        {
+          auto it=states.find(info.getMAC());
+          it->second.info=info;
+          it->second.seconds=std::chrono::duration<double>(now-start).count();
+
+          std::cout << mac2string(info.getMAC()) << " returned after "
+                    << std::fixed << std::setprecision(1)
+                    << it->second.seconds << " s" << std::endl;
+        }
+      }
+    }
+
+    tracker.endRound();
+  }
+
+  // report all devices
+
+  std::vector<std::vector<std::string>> to_be_printed;
+  to_be_printed.push_back({"Name", "IP", "MAC", "Result"});
+
+  for (const auto &state : states)
+  {
+    const rcdiscover::DeviceInfo &info=state.second.info;
+
+    std::ostringstream result;
+    if (tracker.getState(state.first) == RebootTracker::Returned)
+    {
+      result << "Returned after " << std::fixed << std::setprecision(1)
+             << state.second.seconds << " s";
+    }
+    else if (tracker.getState(state.first) == RebootTracker::Gone)
+    {
+      result << "Did not return";
+    }
+    else
+    {
+      result << "Did not reboot";
+    }
+
+    to_be_printed.push_back({info.getUserName().empty() ? info.getModelName() :
+                             info.getUserName(), ip2string(info.getIP()),
+                             mac2string(info.getMAC()), result.str()});
+  }
+
+  printTable(std::cout, to_be_printed);
+
+  return tracker.getOpen() == 0;
 }
 
 int runReset(const std::string &command, int argc, char **argv)
 {
   DeviceFilter device_filter{};
   bool yes = false;
+  int expect = 0;
+  bool confirm = false;
+  int timeout = 180;
+  rcdiscover::InterfaceFilter iface_filter;
 
   if (argc == 0)
   {
@@ -123,6 +256,44 @@ int runReset(const std::string &command, int argc, char **argv)
     {
       yes = true;
     }
+    else if (p == "--confirm")
+    {
+      confirm = true;
+    }
+    else if ((p == "--expect" || p == "--timeout") && i < argc)
+    {
+      try
+      {
+        if (p == "--expect")
+        {
+          expect = std::stoi(argv[i++]);
+        }
+        else
+        {
+          timeout = std::stoi(argv[i++]);
+        }
+      }
+      catch (const std::exception &)
+      {
+        std::cerr << "Invalid value of " << p << ": " << argv[i-1] << '\n';
+        printHelp(std::cerr, command);
+        return 1;
+      }
+    }
+    else if ((p == "--iface" || p == "--iface-exclude" ||
+              p == "--skip-type") && i < argc)
+    {
+      try
+      {
+        parseInterfaceArgument(p, argv[i++], iface_filter);
+      }
+      catch (const std::invalid_argument &ex)
+      {
+        std::cerr << ex.what() << std::endl;
+        printHelp(std::cerr, command);
+        return 1;
+      }
+    }
     else if (p == "-f")
     {
       try
@@ -157,7 +328,10 @@ int runReset(const std::string &command, int argc, char **argv)
     printHelp(std::cerr, command);
     return 1;
   }
-  const auto devices = discoverWithFilter(device_filter);
+  // sockets are shared by discovery and all following commands
+
+  rcdiscover::Session session(iface_filter);
+  const auto devices = discoverWithFilter(session, device_filter, expect);
 
   if (devices.empty())
   {
@@ -180,10 +354,25 @@ int runReset(const std::string &command, int argc, char **argv)
     }
   }
 
+  // send all magic packets at once, only one per device even if it has been
+  // found on several interfaces
+
+  std::vector<std::pair<uint64_t, std::array<uint8_t, 4>>> targets;
   for (const auto &device : devices)
   {
-    rcdiscover::WOL wol(device.getMAC(), 9);
-    wol.send({{0xEE, 0xEE, 0xEE, reset_command->second.id}});
+    if (targets.empty() || targets.back().first != device.getMAC())
+    {
+      targets.emplace_back(device.getMAC(), std::array<uint8_t, 4>{
+        {0xEE, 0xEE, 0xEE, reset_command->second.id}});
+    }
+  }
+
+  session.sendWOL(targets);
+
+  if (confirm)
+  {
+    std::cout << "Waiting for devices to reboot..." << std::endl;
+    return waitForReturn(session, devices, timeout) ? 0 : 1;
   }
 
   std::cout << "Done" << std::endl;
@@ -0,0 +1,102 @@
+/*
+ * rcdiscover - the network discovery tool for Roboception devices
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "reboot_tracker.h"
+
+RebootTracker::RebootTracker(int missed_rounds) :
+  missed_rounds_(missed_rounds), open_(0)
+{ }
+
+void RebootTracker::add(uint64_t mac)
+{
+  if (devices_.insert(std::make_pair(mac, Device{Running, 0, false})).second)
+  {
+    open_++;
+  }
+}
+
+bool RebootTracker::answered(uint64_t mac)
+{
+  auto it=devices_.find(mac);
+
+  if (it == devices_.end())
+  {
+    return false;
+  }
+
+  Device &device=it->second;
+  device.seen=true;
+
+  if (device.state == Gone)
+  {
+    device.state=Returned;
+    open_--;
+    return true;
+  }
+
+  return false;
+}
+
+void RebootTracker::endRound()
+{
+  for (auto &it : devices_)
+  {
+    Device &device=it.second;
+
+    if (device.state == Running)
+    {
+      if (device.seen)
+      {
+        device.missed=0;
+      }
+      else if (++device.missed >= missed_rounds_)
+      {
+        device.state=Gone;
+      }
+    }
+
+    device.seen=false;
+  }
+}
+
+RebootTracker::State RebootTracker::getState(uint64_t mac) const
+{
+  auto it=devices_.find(mac);
+
+  if (it == devices_.end())
+  {
+    return Running;
+  }
+
+  return it->second.state;
+}
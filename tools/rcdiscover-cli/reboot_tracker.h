@@ -0,0 +1,116 @@
+/*
+ * rcdiscover - the network discovery tool for Roboception devices
+ *
+ * Copyright (c) 2026 Roboception GmbH
+ * All rights reserved
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its contributors
+ * may be used to endorse or promote products derived from this software without
+ * specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef RCDISCOVER_REBOOT_TRACKER_H
+#define RCDISCOVER_REBOOT_TRACKER_H
+
+#include <map>
+#include <cstdint>
+#include <cstddef>
+
+/*
+  Tracks the reboot of devices from the answers to repeated discovery rounds.
+  A device counts as gone after it has missed a number of consecutive rounds,
+  so that a single lost response does not count as reboot. It counts as
+  returned as soon as it answers again afterwards.
+*/
+
+class RebootTracker
+{
+  public:
+
+    enum State
+    {
+      Running,
+      Gone,
+      Returned
+    };
+
+    /*
+      @param missed_rounds Number of consecutive rounds without answer after
+                           which a device counts as gone.
+    */
+
+    explicit RebootTracker(int missed_rounds=3);
+
+    /*
+      Adds a device that is expected to reboot.
+
+      @param mac MAC address of device.
+    */
+
+    void add(uint64_t mac);
+
+    /*
+      Records an answer of a device in the current round.
+
+      @param mac MAC address of device.
+      @return    True if the device has returned with this answer.
+    */
+
+    bool answered(uint64_t mac);
+
+    /*
+      Ends the current round. Devices that did not answer count one more
+      missed round.
+    */
+
+    void endRound();
+
+    /*
+      Returns the state of a device, which is Running for unknown devices.
+    */
+
+    State getState(uint64_t mac) const;
+
+    /*
+      Returns the number of devices that have not returned yet.
+    */
+
+    std::size_t getOpen() const { return open_; }
+
+  private:
+
+    struct Device
+    {
+      State state;
+      int missed;
+      bool seen;
+    };
+
+    int missed_rounds_;
+    std::map<uint64_t, Device> devices_;
+    std::size_t open_;
+};
+
+#endif
@@ -57,6 +57,7 @@ int main(int argc, char *argv[])
   int width=1180;
   int height=394;
   int only_rc=1;
+  int tcp_reachable=0;
   std::string filter;
   int sort_col=0;
   bool sort_down=true;
@@ -112,6 +113,7 @@ int main(int argc, char *argv[])
           if (key == "width") width=std::stoi(value);
           if (key == "height") height=std::stoi(value);
           if (key == "only_rc") only_rc=std::stoi(value);
+          if (key == "tcp_reachable") tcp_reachable=std::stoi(value);
           if (key == "filter") filter=value;
           if (key == "sort_col") sort_col=std::stoi(value);
           if (key == "sort_down") sort_down=static_cast<bool>(std::stoi(value));
@@ -135,7 +137,7 @@ int main(int argc, char *argv[])
 
     // create main window
 
-    DiscoverWindow *window=new DiscoverWindow(width, height, only_rc, filter);
+    DiscoverWindow *window=new DiscoverWindow(width, height, only_rc, filter, tcp_reachable);
     window->setSorting(sort_col, sort_down);
 
     // set icon
@@ -165,6 +167,7 @@ int main(int argc, char *argv[])
       out << "width " << window->w() << std::endl;
       out << "height " << window->h() << std::endl;
       out << "only_rc " << window->getOnlyRCValue() << std::endl;
+      out << "tcp_reachable " << window->getTCPReachableValue() << std::endl;
 
       filter=window->getFilterValue();
       if (filter.size() > 0)
@@ -72,27 +72,22 @@ void DeviceList::clear()
   // clear table
 
   device.clear();
+  device_index.clear();
   index.clear();
   rows(0);
 }
 
 void DeviceList::add(const char *name, const char *manufacturer, const char *model, const char *sn,
-      const char *ip, const char *mac, const char *interface, bool reachable)
+      const char *ip, const char *mac, const char *interface)
 {
   // check if device with this mac address already exists
 
-  int k=-1;
-  for (size_t i=0; i<device.size(); i++)
-  {
-    if (device[i].item[5].compare(mac) == 0)
-    {
-      k=static_cast<int>(i);
-      break;
-    }
-  }
+  const auto it=device_index.find(mac);
 
-  if (k >= 0)
+  if (it != device_index.end())
   {
+    const size_t k=it->second;
+
     // insert interface if it does not already exist
 
     if (device[k].interface_list.insert(interface).second)
@@ -110,16 +105,6 @@ void DeviceList::add(const char *name, const char *manufacturer, const char *mod
       }
 
       device[k].item[6]=out.str();
-      device[k].reachable|=reachable;
-
-      if (device[k].reachable)
-      {
-        device[k].item[7]="\u2713";
-      }
-      else
-      {
-        device[k].item[7]="\u2717";
-      }
 
       redraw();
     }
@@ -139,20 +124,14 @@ void DeviceList::add(const char *name, const char *manufacturer, const char *mod
 
     data.interface_list.insert(interface);
 
-    if (reachable)
-    {
-      data.item[7]=u8"\u2713";
-    }
-    else
-    {
-      data.item[7]=u8"\u2717";
-    }
+    data.item[7]=u8"\u2026";
 
-    data.reachable=reachable;
+    data.reachable=false;
     data.new_discovery=(previous_mac_list.size() > 0 && previous_mac_list.find(mac) == previous_mac_list.end());
     new_discovery=(new_discovery || data.new_discovery);
 
     device.push_back(data);
+    device_index[data.item[5]]=device.size()-1;
 
     if (addDeviceIndex(device.size()-1))
     {
@@ -161,6 +140,29 @@ void DeviceList::add(const char *name, const char *manufacturer, const char *mod
   }
 }
 
+void DeviceList::setReachable(const char *mac, bool reachable)
+{
+  const auto it=device_index.find(mac);
+
+  if (it != device_index.end())
+  {
+    DeviceListData &data=device[it->second];
+
+    data.reachable|=reachable;
+
+    if (data.reachable)
+    {
+      data.item[7]=u8"\u2713";
+    }
+    else
+    {
+      data.item[7]=u8"\u2717";
+    }
+
+    redraw();
+  }
+}
+
 int DeviceList::getSelectedRow()
 {
   int sel=-1;
@@ -17,6 +17,7 @@
 
 #include <vector>
 #include <set>
+#include <unordered_map>
 #include <string>
 
 class DeviceList : public Fl_Table_Row
@@ -28,7 +29,11 @@ class DeviceList : public Fl_Table_Row
     void clear();
 
     void add(const char *name, const char *manufacturer, const char *model, const char *sn,
-      const char *ip, const char *mac, const char *interface, bool reachable);
+      const char *ip, const char *mac, const char *interface);
+
+    // reachability of devices is pending until it is set
+
+    void setReachable(const char *mac, bool reachable);
 
     void setSelectionChangeCallback(Fl_Callback* _cb, void* p) { cb=_cb; user=p; }
 
@@ -73,6 +78,7 @@ class DeviceList : public Fl_Table_Row
     };
 
     std::vector<DeviceListData> device; // all discovered devices
+    std::unordered_map<std::string, size_t> device_index; // MAC to device
     std::vector<size_t> index; // indices of visible devices in sorted order
 
     Fl_Callback *cb;
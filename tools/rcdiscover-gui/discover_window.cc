@@ -22,6 +22,8 @@
 
 #include "rcdiscover/discover.h"
 #include "rcdiscover/ping.h"
+#include "rcdiscover/stop_policy.h"
+#include "rcdiscover/device_deduplicator.h"
 
 #include <FL/fl_draw.H>
 #include <FL/fl_ask.H>
@@ -37,8 +39,10 @@
 
 #include <sstream>
 #include <iomanip>
-#include <chrono>
 #include <iostream>
+#include <set>
+#include <mutex>
+#include <condition_variable>
 
 namespace
 {
@@ -73,6 +77,12 @@ void onlyRCCb(Fl_Widget *, void *user_data)
   win->doOnlyRC();
 }
 
+void tcpReachableCb(Fl_Widget *, void *user_data)
+{
+  DiscoverWindow *win=reinterpret_cast<DiscoverWindow *>(user_data);
+  win->doTCPReachable();
+}
+
 void filterCb(Fl_Widget *, void *user_data)
 {
   DiscoverWindow *win=reinterpret_cast<DiscoverWindow *>(user_data);
@@ -126,11 +136,13 @@ void reconnectCb(Fl_Widget *, void *user_data)
 
 }
 
-DiscoverWindow::DiscoverWindow(int ww, int hh, int _only_rc, const std::string &_filter) :
+DiscoverWindow::DiscoverWindow(int ww, int hh, int _only_rc, const std::string &_filter,
+                               int _tcp_reachable) :
   Fl_Double_Window(1180, 394, "rcdiscover")
 {
   running=false;
   discover_thread=0;
+  reachable_mode=rcdiscover::ReachabilityMode::ICMP;
 
   int width=1180-2*GAP_SIZE;
   int row_height=28;
@@ -156,11 +168,16 @@ DiscoverWindow::DiscoverWindow(int ww, int hh, int _only_rc, const std::string &
     only_rc->value(_only_rc);
     only_rc->callback(onlyRCCb, this);
 
+    tcp_reachable=new Fl_Check_Button(ADD_RIGHT_XY, 170, row_height, "Reachable via WebGUI");
+    tcp_reachable->value(_tcp_reachable);
+    tcp_reachable->callback(tcpReachableCb, this);
+    tcp_reachable->tooltip("Check reachability by connecting to the WebGUI port instead of ping.");
+
     filter=new InputFilter(addRightX()+40, addRightY(), 150, row_height, "Filter");
     filter->value(_filter.c_str());
     filter->setChangeCallback(filterCb, this);
 
-    Fl_Group *empty=new Fl_Group(ADD_RIGHT_XY, width-5*GAP_SIZE-(160+45+150+190+row_height), row_height);
+    Fl_Group *empty=new Fl_Group(ADD_RIGHT_XY, width-6*GAP_SIZE-(160+45+150+170+190+row_height), row_height);
     empty->end();
     group->resizable(empty);
 
@@ -262,6 +279,9 @@ void DiscoverWindow::doDiscover()
     discover_thread=0;
   }
 
+  reachable_mode=tcp_reachable->value() ? rcdiscover::ReachabilityMode::TCP :
+    rcdiscover::ReachabilityMode::ICMP;
+
   running=true;
   discover_thread=new std::thread(&DiscoverWindow::discoverThread, this);
 
@@ -274,6 +294,13 @@ void DiscoverWindow::doOnlyRC()
   update();
 }
 
+void DiscoverWindow::doTCPReachable()
+{
+  // check reachability of all devices again with the selected method
+
+  doDiscover();
+}
+
 void DiscoverWindow::doFilter()
 {
   list->filter(filter->value());
@@ -347,6 +374,7 @@ void DiscoverWindow::doReset()
   if (list->isRCVisardSelected() || mac.size() == 0)
   {
     ResetWindow *win=ResetWindow::showWindow();
+    win->setReachabilityCache(&reachable_cache);
     win->updateDevices(list->getCurrentNameMACList(true), mac);
   }
 }
@@ -354,12 +382,14 @@ void DiscoverWindow::doReset()
 void DiscoverWindow::doSetTmpIP()
 {
   SetTmpIPWindow *win=SetTmpIPWindow::showWindow();
+  win->setReachabilityCache(&reachable_cache);
   win->updateDevices(list->getCurrentNameMACList(false), list->getSelectedMAC());
 }
 
 void DiscoverWindow::doReconnect()
 {
   ReconnectWindow *win=ReconnectWindow::showWindow();
+  win->setReachabilityCache(&reachable_cache);
   win->updateDevices(list->getCurrentNameMACList(false), list->getSelectedMAC());
 }
 
@@ -387,14 +417,19 @@ void DiscoverWindow::update()
     reset->deactivate();
   }
 
+  // changing the reachability check starts a new discovery, which must not
+  // join the running discovery thread while the GUI lock is held
+
   if (running)
   {
     discover->deactivate();
+    tcp_reachable->deactivate();
     logo->startSpinning();
   }
   else
   {
     discover->activate();
+    tcp_reachable->activate();
     logo->stopSpinning();
   }
 
@@ -403,6 +438,77 @@ void DiscoverWindow::update()
 
 void DiscoverWindow::discoverThread()
 {
+  // reachability of new devices is checked in a separate thread, which
+  // pings all devices that have been queued in the meantime at once, so that
+  // discovery is not delayed and the lock is only held for updating the table.
+  // Devices that have been checked recently are taken from the cache.
+
+  std::mutex ping_mutex;
+  std::condition_variable ping_cv;
+  std::vector<std::pair<std::string, rcdiscover::DeviceInfo> > ping_queue;
+  bool ping_done=false;
+
+  std::thread ping_thread([this, &ping_mutex, &ping_cv, &ping_queue, &ping_done]()
+  {
+    std::unique_lock<std::mutex> lock(ping_mutex);
+
+    while (true)
+    {
+      ping_cv.wait(lock, [&ping_queue, &ping_done]()
+      {
+        return ping_done || !ping_queue.empty();
+      });
+
+      if (ping_queue.empty())
+      {
+        break;
+      }
+
+      std::vector<std::pair<std::string, rcdiscover::DeviceInfo> > batch;
+      batch.swap(ping_queue);
+      lock.unlock();
+
+      std::vector<rcdiscover::DeviceInfo> devices;
+      for (const auto &device : batch)
+      {
+        devices.push_back(device.second);
+      }
+
+      std::vector<bool> reachable(batch.size(), false);
+
+      try
+      {
+        reachable=reachable_cache.check(devices, reachable_mode);
+      }
+      catch (const std::exception &ex)
+      {
+        std::cerr << "Exception in reachability check: " << ex.what() << std::endl;
+      }
+
+      // the window may wait for this thread while holding the lock if
+      // discovery has been cancelled
+
+      if (!running)
+      {
+        lock.lock();
+        continue;
+      }
+
+      Fl::lock();
+
+      for (size_t k=0; k<batch.size(); k++)
+      {
+        list->setReachable(batch[k].first.c_str(), reachable[k]);
+      }
+
+      update();
+      Fl::unlock();
+      Fl::awake();
+
+      lock.lock();
+    }
+  });
+
   try
   {
     // clear list and update to deactive discover button
@@ -413,28 +519,41 @@ void DiscoverWindow::discoverThread()
     Fl::unlock();
     Fl::awake();
 
-    // broadcast discovery request
+    // broadcast discovery request, sockets are only recreated if interfaces
+    // have changed since the last run
 
-    rcdiscover::Discover discover;
+    if (!iface_cache)
+    {
+      iface_cache=std::make_shared<rcdiscover::InterfaceCache>();
+    }
+
+    rcdiscover::Discover discover(iface_cache);
     discover.broadcastRequest();
 
     // collecting answers
 
-    std::chrono::steady_clock::time_point tstart=std::chrono::steady_clock::now();
-    std::chrono::steady_clock::time_point tend=tstart;
+    rcdiscover::StopPolicy policy=rcdiscover::StopPolicy::fixed();
+    policy.start();
 
+    rcdiscover::DeviceDeduplicator devices;
+    std::set<uint64_t> pinged;
     std::vector<rcdiscover::DeviceInfo> info;
 
-    while (running && (discover.getResponse(info, 100) ||
-      std::chrono::duration<double, std::milli>(tend-tstart).count() < 1000))
+    while (running && !policy.isDone())
     {
+      discover.getAllResponses(info, policy.getTimeout());
+      policy.update(info, 0);
+
       // add answers immediately to table
 
       Fl::lock();
 
       for (size_t k=0; k<info.size(); k++)
       {
-        if (info[k].isValid())
+        // skip multiple responses of a device on the same interface
+
+        if (info[k].isValid() &&
+            devices.add(info[k]) != rcdiscover::DeviceDeduplicator::Duplicate)
         {
           std::ostringstream ip, mac;
 
@@ -455,8 +574,16 @@ void DiscoverWindow::discoverThread()
             info[k].getSerialNumber().c_str(),
             ip.str().c_str(),
             mac.str().c_str(),
-            info[k].getIfaceName().c_str(),
-            checkReachabilityOfSensor(info[k]));
+            info[k].getIfaceName().c_str());
+
+          // ping every device only once, regardless of the interfaces
+
+          if (pinged.insert(info[k].getMAC()).second)
+          {
+            std::lock_guard<std::mutex> lock(ping_mutex);
+            ping_queue.push_back(std::make_pair(mac.str(), info[k]));
+            ping_cv.notify_one();
+          }
         }
       }
 
@@ -465,7 +592,6 @@ void DiscoverWindow::discoverThread()
       Fl::awake();
 
       info.clear();
-      tend=std::chrono::steady_clock::now();
     }
   }
   catch (const std::exception &ex)
@@ -483,6 +609,16 @@ void DiscoverWindow::discoverThread()
     std::cerr << "Unknown exception in discover thread" << std::endl;
   }
 
+  // wait for outstanding reachability checks
+
+  {
+    std::lock_guard<std::mutex> lock(ping_mutex);
+    ping_done=true;
+    ping_cv.notify_one();
+  }
+
+  ping_thread.join();
+
   // leaving discover thread and update to activate discover button
 
   Fl::lock();
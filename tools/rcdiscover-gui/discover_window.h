@@ -18,6 +18,9 @@
 #include "input_filter.h"
 #include "logo.h"
 
+#include "rcdiscover/ping.h"
+#include "rcdiscover/reachability_cache.h"
+
 #include <FL/Fl.H>
 #include <FL/Fl_Double_Window.H>
 #include <FL/Fl_Check_Button.H>
@@ -29,21 +32,29 @@
 #include <atomic>
 #include <thread>
 
+namespace rcdiscover
+{
+class InterfaceCache;
+}
+
 class DiscoverWindow : public Fl_Double_Window
 {
   public:
 
-    DiscoverWindow(int ww, int hh, int _only_rc, const std::string &_filter);
+    DiscoverWindow(int ww, int hh, int _only_rc, const std::string &_filter,
+                   int _tcp_reachable=0);
     ~DiscoverWindow();
 
     void getSorting(int &sort_col, bool &sort_down) { list->getSorting(sort_col, sort_down); }
     void setSorting(int sort_col, bool sort_down)  { list->setSorting(sort_col, sort_down); }
 
     int getOnlyRCValue() { return only_rc->value(); }
+    int getTCPReachableValue() { return tcp_reachable->value(); }
     const char *getFilterValue() { return filter->value(); }
 
     void doDiscover();
     void doOnlyRC();
+    void doTCPReachable();
     void doFilter();
     void doOpenContextMenu();
     void doCopyToClipboard(int i);
@@ -62,10 +73,21 @@ class DiscoverWindow : public Fl_Double_Window
     std::atomic_bool running;
     std::thread *discover_thread;
 
+    // method for checking reachability, which is set before starting the
+    // discover thread
+    rcdiscover::ReachabilityMode reachable_mode;
+
+    // reachability results of previous discoveries
+    rcdiscover::ReachabilityCache reachable_cache;
+
+    // sockets of all interfaces, which are only used by the discover thread
+    std::shared_ptr<rcdiscover::InterfaceCache> iface_cache;
+
     MenuBar *menu_bar;
 
     Button *discover;
     Fl_Check_Button *only_rc;
+    Fl_Check_Button *tcp_reachable;
     InputFilter *filter;
     Logo *logo;
     DeviceList *list;
@@ -16,6 +16,7 @@
 #include "label.h"
 
 #include "rcdiscover/force_ip.h"
+#include "rcdiscover/reachability_cache.h"
 
 #include <FL/fl_ask.H>
 
@@ -125,6 +126,11 @@ void ReconnectWindow::isReconnect()
         "No", "Yes", 0, mac->value()) == 1)
       {
         force_ip.sendCommand(mac->getMAC(), 0, 0, 0);
+
+        if (reachable_cache)
+        {
+          reachable_cache->invalidate(mac->getMAC());
+        }
       }
 
       hide();
@@ -136,7 +142,8 @@ void ReconnectWindow::isReconnect()
   }
 }
 
-ReconnectWindow::ReconnectWindow() : Fl_Double_Window(400, 124, "Reconnect device")
+ReconnectWindow::ReconnectWindow() : Fl_Double_Window(400, 124, "Reconnect device"),
+  reachable_cache(0)
 {
   int width=400-2*GAP_SIZE;
   int row_height=28;
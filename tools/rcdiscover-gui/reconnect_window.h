@@ -19,6 +19,11 @@
 #include <FL/Fl.H>
 #include <FL/Fl_Double_Window.H>
 
+namespace rcdiscover
+{
+class ReachabilityCache;
+}
+
 #include <vector>
 #include <utility>
 
@@ -32,6 +37,12 @@ class ReconnectWindow : public Fl_Double_Window
     void updateDevices(const std::vector<std::pair<std::string, std::string> > &list,
       const std::string &sel_mac);
 
+    // results of the given cache are invalidated for devices that are
+    // changed by this window
+
+    void setReachabilityCache(rcdiscover::ReachabilityCache *cache)
+    { reachable_cache=cache; }
+
     void update();
 
     void isChangingDevice();
@@ -45,6 +56,8 @@ class ReconnectWindow : public Fl_Double_Window
     InputMAC *mac;
     Button *reconnect;
     Button *help;
+
+    rcdiscover::ReachabilityCache *reachable_cache;
 };
 
 #endif
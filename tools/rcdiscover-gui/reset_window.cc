@@ -18,6 +18,7 @@
 #include "rcdiscover/wol.h"
 #include "rcdiscover/wol_exception.h"
 #include "rcdiscover/operation_not_permitted.h"
+#include "rcdiscover/reachability_cache.h"
 
 #include <FL/fl_ask.H>
 
@@ -143,7 +144,7 @@ namespace
 {
 
 void sendUDPRequest(const char *mac_string, uint64_t mac_value, const char *func_name,
-  uint8_t func_id)
+  uint8_t func_id, rcdiscover::ReachabilityCache *cache)
 {
   if (mac_value != 0)
   {
@@ -168,6 +169,14 @@ void sendUDPRequest(const char *mac_string, uint64_t mac_value, const char *func
       while (answer == 1)
       {
         wol.send({{0xEE, 0xEE, 0xEE, func_id}});
+
+        // the device becomes unreachable while rebooting
+
+        if (cache)
+        {
+          cache->invalidate(mac_value);
+        }
+
         answer=fl_choice("Please check whether rc_visard's LED turned white and whether rc_visard is rebooting.",
           "Close", "Try again", 0);
       }
@@ -187,29 +196,30 @@ void sendUDPRequest(const char *mac_string, uint64_t mac_value, const char *func
 
 void ResetWindow::isResetParameters()
 {
-  sendUDPRequest(mac->value(), mac->getMAC(), "reset parameters", 0xAA);
+  sendUDPRequest(mac->value(), mac->getMAC(), "reset parameters", 0xAA, reachable_cache);
   hide();
 }
 
 void ResetWindow::isResetNetwork()
 {
-  sendUDPRequest(mac->value(), mac->getMAC(), "reset network parameters", 0xBB);
+  sendUDPRequest(mac->value(), mac->getMAC(), "reset network parameters", 0xBB, reachable_cache);
   hide();
 }
 
 void ResetWindow::isResetAll()
 {
-  sendUDPRequest(mac->value(), mac->getMAC(), "reset all", 0xFF);
+  sendUDPRequest(mac->value(), mac->getMAC(), "reset all", 0xFF, reachable_cache);
   hide();
 }
 
 void ResetWindow::isSwitchPartitions()
 {
-  sendUDPRequest(mac->value(), mac->getMAC(), "switch partition", 0xCC);
+  sendUDPRequest(mac->value(), mac->getMAC(), "switch partition", 0xCC, reachable_cache);
   hide();
 }
 
-ResetWindow::ResetWindow() : Fl_Double_Window(628, 124, "Reset rc_visard")
+ResetWindow::ResetWindow() : Fl_Double_Window(628, 124, "Reset rc_visard"),
+  reachable_cache(0)
 {
   int width=628-2*GAP_SIZE;
   int row_height=28;
@@ -19,6 +19,11 @@
 #include <FL/Fl.H>
 #include <FL/Fl_Double_Window.H>
 
+namespace rcdiscover
+{
+class ReachabilityCache;
+}
+
 class ResetWindow : public Fl_Double_Window
 {
   public:
@@ -29,6 +34,12 @@ class ResetWindow : public Fl_Double_Window
     void updateDevices(const std::vector<std::pair<std::string, std::string> > &list,
       const std::string &sel_mac);
 
+    // results of the given cache are invalidated for devices that are
+    // changed by this window
+
+    void setReachabilityCache(rcdiscover::ReachabilityCache *cache)
+    { reachable_cache=cache; }
+
     void update();
 
     void isChangingDevice();
@@ -48,6 +59,8 @@ class ResetWindow : public Fl_Double_Window
     Button *reset_all;
     Button *switch_partitions;
     Button *help;
+
+    rcdiscover::ReachabilityCache *reachable_cache;
 };
 
 #endif
@@ -16,6 +16,10 @@
 #include "label.h"
 
 #include "rcdiscover/force_ip.h"
+#include "rcdiscover/arp_probe.h"
+#include "rcdiscover/operation_not_permitted.h"
+#include "rcdiscover/reachability_cache.h"
+#include "rcdiscover/utils.h"
 
 #include <FL/fl_ask.H>
 
@@ -54,6 +58,12 @@ void setCb(Fl_Widget *, void *user_data)
   win->isSet();
 }
 
+void probedCb(void *user_data)
+{
+  SetTmpIPWindow *win=reinterpret_cast<SetTmpIPWindow *>(user_data);
+  win->isProbed();
+}
+
 void clearCb(Fl_Widget *, void *user_data)
 {
   SetTmpIPWindow *win=reinterpret_cast<SetTmpIPWindow *>(user_data);
@@ -115,7 +125,8 @@ void SetTmpIPWindow::update()
     mac->deactivate();
   }
 
-  if (mac->isValid() && ip->isValid() && subnet_mask->isValid() && default_gateway->isValid())
+  if (!probe_thread && mac->isValid() && ip->isValid() && subnet_mask->isValid() &&
+    default_gateway->isValid())
   {
     set_ip->activate();
   }
@@ -173,35 +184,111 @@ void SetTmpIPWindow::doSubnetMask()
 
 void SetTmpIPWindow::isSet()
 {
-  if (mac->isValid() && ip->isValid() && subnet_mask->isValid() && default_gateway->isValid())
+  if (!probe_thread && mac->isValid() && ip->isValid() && subnet_mask->isValid() &&
+    default_gateway->isValid())
   {
-    try
+    if ((ip->getIP() & subnet_mask->getIP()) != (default_gateway->getIP() & subnet_mask->getIP()))
     {
-      if ((ip->getIP() & subnet_mask->getIP()) != (default_gateway->getIP() & subnet_mask->getIP()))
+      if (fl_choice("IP address and gateway appear to be in different subnets. ",
+        "Cancel", "Proceed", 0) != 1)
       {
-        if (fl_choice("IP address and gateway appear to be in different subnets. ",
-          "Cancel", "Proceed", 0) != 1)
-        {
-          return;
-        }
+        return;
       }
+    }
 
-      rcdiscover::ForceIP force_ip;
+    new_mac=mac->getMAC();
+    new_ip=ip->getIP();
+    new_subnet=subnet_mask->getIP();
+    new_gateway=default_gateway->getIP();
 
-      if (fl_choice("Are you sure to set the IP address of the device with MAC-address %s?",
-        "No", "Yes", 0, mac->value()) == 1)
-      {
-        force_ip.sendCommand(mac->getMAC(), ip->getIP(), subnet_mask->getIP(),
-          default_gateway->getIP());
+    // the ARP probes take up to half a second and are therefore sent in a
+    // separate thread, which continues with isProbed()
+
+    probe_thread=new std::thread(&SetTmpIPWindow::probeThread, this);
+
+    update();
+  }
+}
+
+void SetTmpIPWindow::probeThread()
+{
+  probe_conflict=false;
+  probe_conflict_mac=0;
+  probe_error.clear();
+
+  // check with ARP probes if the address is used by another host, which
+  // is not possible without the necessary privileges
 
-        hide();
+  try
+  {
+    const auto result=rcdiscover::ArpProbe::check({{new_ip, "", new_mac}});
+
+    if (result[0].conflict)
+    {
+      probe_conflict=true;
+      probe_conflict_mac=result[0].mac;
+    }
+  }
+  catch (const rcdiscover::OperationNotPermitted &)
+  { }
+  catch (const std::exception &ex)
+  {
+    probe_error=ex.what();
+  }
+
+  Fl::awake(probedCb, this);
+}
+
+void SetTmpIPWindow::isProbed()
+{
+  if (!probe_thread)
+  {
+    return;
+  }
+
+  probe_thread->join();
+  delete probe_thread;
+  probe_thread=0;
+
+  update();
+
+  if (!probe_error.empty())
+  {
+    fl_alert("%s", probe_error.c_str());
+    return;
+  }
+
+  try
+  {
+    if (probe_conflict)
+    {
+      if (fl_choice("IP address %s is already used by the host with MAC-address %s. ",
+        "Cancel", "Proceed", 0, ip2string(new_ip).c_str(),
+        mac2string(probe_conflict_mac).c_str()) != 1)
+      {
+        return;
       }
     }
-    catch (const std::runtime_error &ex)
+
+    rcdiscover::ForceIP force_ip;
+
+    if (fl_choice("Are you sure to set the IP address of the device with MAC-address %s?",
+      "No", "Yes", 0, mac2string(new_mac).c_str()) == 1)
     {
-      fl_alert("%s", ex.what());
+      force_ip.sendCommand(new_mac, new_ip, new_subnet, new_gateway);
+
+      if (reachable_cache)
+      {
+        reachable_cache->invalidate(new_mac);
+      }
+
+      hide();
     }
   }
+  catch (const std::runtime_error &ex)
+  {
+    fl_alert("%s", ex.what());
+  }
 }
 
 void SetTmpIPWindow::isClear()
@@ -213,7 +300,9 @@ void SetTmpIPWindow::isClear()
   update();
 }
 
-SetTmpIPWindow::SetTmpIPWindow() : Fl_Double_Window(480, 238, "Set temporary IP address")
+SetTmpIPWindow::SetTmpIPWindow() : Fl_Double_Window(480, 238, "Set temporary IP address"),
+  probe_thread(0), new_mac(0), new_ip(0), new_subnet(0), new_gateway(0),
+  probe_conflict(false), probe_conflict_mac(0), reachable_cache(0)
 {
   int width=480-2*GAP_SIZE;
   int row_height=28;
@@ -253,3 +342,12 @@ SetTmpIPWindow::SetTmpIPWindow() : Fl_Double_Window(480, 238, "Set temporary IP
 
   size_range(w(), h(), w(), h());
 }
+
+SetTmpIPWindow::~SetTmpIPWindow()
+{
+  if (probe_thread)
+  {
+    probe_thread->join();
+    delete probe_thread;
+  }
+}
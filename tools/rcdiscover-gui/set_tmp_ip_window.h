@@ -20,8 +20,16 @@
 #include <FL/Fl.H>
 #include <FL/Fl_Double_Window.H>
 
+namespace rcdiscover
+{
+class ReachabilityCache;
+}
+
 #include <vector>
 #include <utility>
+#include <string>
+#include <thread>
+#include <cstdint>
 
 class SetTmpIPWindow : public Fl_Double_Window
 {
@@ -30,21 +38,32 @@ class SetTmpIPWindow : public Fl_Double_Window
     static SetTmpIPWindow *showWindow();
     static void hideWindow();
 
+    ~SetTmpIPWindow();
+
     void updateDevices(const std::vector<std::pair<std::string, std::string> > &list,
       const std::string &sel_mac);
 
+    // results of the given cache are invalidated for devices that are
+    // changed by this window
+
+    void setReachabilityCache(rcdiscover::ReachabilityCache *cache)
+    { reachable_cache=cache; }
+
     void update();
 
     void isChangingDevice();
     void doIP();
     void doSubnetMask();
     void isSet();
+    void isProbed();
     void isClear();
 
   private:
 
     SetTmpIPWindow();
 
+    void probeThread();
+
     DeviceChoice *device;
     InputMAC *mac;
     InputIP *ip;
@@ -53,6 +72,21 @@ class SetTmpIPWindow : public Fl_Double_Window
     Button *set_ip;
     Button *clear_form;
     Button *help;
+
+    rcdiscover::ReachabilityCache *reachable_cache;
+
+    // parameters of the FORCEIP command, which are checked with ARP probes
+    // in a separate thread before the command is sent
+
+    std::thread *probe_thread;
+    uint64_t new_mac;
+    uint32_t new_ip;
+    uint32_t new_subnet;
+    uint32_t new_gateway;
+
+    bool probe_conflict;
+    uint64_t probe_conflict_mac;
+    std::string probe_error;
 };
 
 #endif
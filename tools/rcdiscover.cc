@@ -39,6 +39,8 @@
 #include "rcdiscover-cli/rcdiscover_force_ip.h"
 #include "rcdiscover-cli/cli_utils.h"
 
+#include "rcdiscover/descriptor_limit.h"
+
 #include <iostream>
 #include <map>
 #include <functional>
@@ -84,6 +86,11 @@ int main(int argc, char *argv[])
 {
   WSA wsa;
 
+  // the command line tool does not use select(), so that it can use more
+  // descriptors than usual for hosts with many interfaces
+
+  rcdiscover::raiseDescriptorLimit(8192);
+
   std::string help_string = std::string("Usage: ") +
       argv[0] + " [-h | --help] [--version] <command> [<args>]\n\n" +
       "Available commands are:\n";